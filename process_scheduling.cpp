@@ -1,9 +1,57 @@
+#include "process_scheduling.h"
+
 #include <iostream>
 #include <vector>
-#include <queue>
 #include <algorithm>
 #include <limits>
 #include <iomanip>
+#include <array>
+#include <iterator>
+#include <span>
+#include <memory>
+#include <ranges>
+#include <string_view>
+#include <charconv>
+#include <cstdint>
+#include <bit>
+#include <cmath>
+#include <numeric>
+#include <type_traits>
+#include <coroutine>
+#include <deque>
+#include <queue>
+#include <exception>
+#include <utility>
+#include <cstddef>
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <set>
+#include <optional>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#if __has_include(<ucontext.h>)
+#include <ucontext.h>
+#define PROCESS_SCHEDULING_HAS_FIBERS 1
+#endif
+#if __has_include(<sys/mman.h>) && !defined(PROCESS_SCHEDULING_NO_HUGE_PAGES)
+#include <sys/mman.h>
+#define PROCESS_SCHEDULING_HAS_HUGE_PAGES 1
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#include <immintrin.h>
+#endif
 
 class Process {
 public:
@@ -17,376 +65,4945 @@ public:
     int responseTime;
     int priority;
 
-    Process(int id, int arrival, int burst, int priority = 0)
+    constexpr Process() : Process(0, 0, 0) {}
+
+    constexpr Process(int id, int arrival, int burst, int priority = 0)
         : id(id), arrivalTime(arrival), burstTime(burst), remainingTime(burst),
           completionTime(0), turnaroundTime(0), waitingTime(0), responseTime(-1), priority(priority) {}
 };
 
-class Scheduler {
-protected:
-    std::vector<Process> processes;
+struct ScheduleMetrics {
     double avgWaitingTime;
     double avgTurnaroundTime;
     double avgResponseTime;
     double throughput;
+};
 
-public:
-    virtual void addProcess(const Process& p) {
-        processes.push_back(p);
+template <typename Range>
+constexpr ScheduleMetrics computeMetrics(Range&& processes) {
+    long long totalWaitingTime = 0;
+    long long totalTurnaroundTime = 0;
+    long long totalResponseTime = 0;
+    int maxCompletionTime = 0;
+    std::size_t processCount = 0;
+
+    for (const auto& p : processes) {
+        ++processCount;
+        totalWaitingTime += p.waitingTime;
+        totalTurnaroundTime += p.turnaroundTime;
+        totalResponseTime += p.responseTime;
+        maxCompletionTime = std::max(maxCompletionTime, p.completionTime);
     }
 
-    virtual void schedule() = 0;
-    
-    virtual void printResults() {
-        std::cout << "Process\tArrival\tBurst\tResponse\tCompletion\tTurnaround\tWaiting\n";
-        for (const auto& p : processes) {
-            std::cout << p.id << "\t" << p.arrivalTime << "\t" << p.burstTime << "\t"
-                      << p.responseTime << "\t\t" << p.completionTime << "\t\t" 
-                      << p.turnaroundTime << "\t\t" << p.waitingTime << "\n";
-        }
-        std::cout << "Average Waiting Time: " << avgWaitingTime << std::endl;
-        std::cout << "Average Turnaround Time: " << avgTurnaroundTime << std::endl;
-        std::cout << "Average Response Time: " << avgResponseTime << std::endl;
-        std::cout << "Throughput: " << throughput << " processes per unit time" << std::endl;
+    const double count = static_cast<double>(processCount);
+    return {totalWaitingTime / count, totalTurnaroundTime / count,
+            totalResponseTime / count, count / maxCompletionTime};
+}
+
+template <typename Range>
+void printSchedule(const Range& processes, const ScheduleMetrics& metrics) {
+    std::cout << "Process\tArrival\tBurst\tResponse\tCompletion\tTurnaround\tWaiting\n";
+    for (const auto& p : processes) {
+        std::cout << p.id << "\t" << p.arrivalTime << "\t" << p.burstTime << "\t"
+                  << p.responseTime << "\t\t" << p.completionTime << "\t\t" 
+                  << p.turnaroundTime << "\t\t" << p.waitingTime << "\n";
     }
+    std::cout << "Average Waiting Time: " << metrics.avgWaitingTime << std::endl;
+    std::cout << "Average Turnaround Time: " << metrics.avgTurnaroundTime << std::endl;
+    std::cout << "Average Response Time: " << metrics.avgResponseTime << std::endl;
+    std::cout << "Throughput: " << metrics.throughput << " processes per unit time" << std::endl;
+}
 
-    void calculateMetrics() {
-        int totalWaitingTime = 0;
-        int totalTurnaroundTime = 0;
-        int totalResponseTime = 0;
-        int maxCompletionTime = 0;
+// Allocator for the large per-process arrays. Blocks of 2 MB or more are
+// mapped directly, from reserved 2 MB pages when the system has some, or
+// otherwise 2 MB aligned and marked MADV_HUGEPAGE for transparent huge pages.
+// Random access into big tables and ready queues then needs far fewer TLB
+// entries. Smaller blocks, and builds without mmap or with
+// PROCESS_SCHEDULING_NO_HUGE_PAGES, go through operator new.
+struct HugePageStats {
+    std::atomic<std::size_t> reservedBytes{0};     // Explicit 2 MB pages.
+    std::atomic<std::size_t> transparentBytes{0};  // madvise(MADV_HUGEPAGE).
+};
 
-        for (const auto& p : processes) {
-            totalWaitingTime += p.waitingTime;
-            totalTurnaroundTime += p.turnaroundTime;
-            totalResponseTime += p.responseTime;
-            maxCompletionTime = std::max(maxCompletionTime, p.completionTime);
-        }
+inline HugePageStats hugePageStats;
 
-        avgWaitingTime = static_cast<double>(totalWaitingTime) / processes.size();
-        avgTurnaroundTime = static_cast<double>(totalTurnaroundTime) / processes.size();
-        avgResponseTime = static_cast<double>(totalResponseTime) / processes.size();
-        throughput = static_cast<double>(processes.size()) / maxCompletionTime;
+inline constexpr std::size_t hugePageSize = std::size_t{2} << 20;
+
+#if PROCESS_SCHEDULING_HAS_HUGE_PAGES
+inline void* mapHugePages(std::size_t bytes) {
+#ifdef MAP_HUGETLB
+    void* reserved = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (reserved != MAP_FAILED) {
+        hugePageStats.reservedBytes += bytes;
+        return reserved;
     }
-};
+#endif
+    // Over-map by a huge page and trim, since transparent huge pages only
+    // back 2 MB aligned ranges.
+    std::size_t span = bytes + hugePageSize;
+    void* mapped = mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) throw std::bad_alloc();
+    char* raw = static_cast<char*>(mapped);
+    char* aligned = raw + (-reinterpret_cast<std::uintptr_t>(raw) & (hugePageSize - 1));
+    if (aligned > raw) munmap(raw, aligned - raw);
+    if (std::size_t tail = raw + span - (aligned + bytes)) munmap(aligned + bytes, tail);
+#ifdef MADV_HUGEPAGE
+    if (madvise(aligned, bytes, MADV_HUGEPAGE) == 0) hugePageStats.transparentBytes += bytes;
+#endif
+    return aligned;
+}
+#endif
 
-class FCFSScheduler : public Scheduler {
+template <typename T>
+class HugePageAllocator {
 public:
-    void schedule() override {
-        std::sort(processes.begin(), processes.end(), 
-                  [](const Process& a, const Process& b) { return a.arrivalTime < b.arrivalTime; });
+    using value_type = T;
 
-        int currentTime = 0;
-        for (auto& p : processes) {
-            if (currentTime < p.arrivalTime) {
-                currentTime = p.arrivalTime;
-            }
-            p.responseTime = currentTime - p.arrivalTime;
-            p.completionTime = currentTime + p.burstTime;
-            p.turnaroundTime = p.completionTime - p.arrivalTime;
-            p.waitingTime = p.turnaroundTime - p.burstTime;
-            currentTime = p.completionTime;
+    HugePageAllocator() = default;
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+#if PROCESS_SCHEDULING_HAS_HUGE_PAGES
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+        if (std::size_t bytes = n * sizeof(T); bytes >= hugePageSize) {
+            return static_cast<T*>(mapHugePages(roundUp(bytes)));
         }
-        calculateMetrics();
+#endif
+        return std::allocator<T>().allocate(n);
     }
 
-    void printResults() override {
-        std::cout << "FCFS Scheduling Results:\n";
-        Scheduler::printResults();
+    void deallocate(T* p, std::size_t n) noexcept {
+#if PROCESS_SCHEDULING_HAS_HUGE_PAGES
+        if (std::size_t bytes = n * sizeof(T); bytes >= hugePageSize) {
+            munmap(p, roundUp(bytes));
+            return;
+        }
+#endif
+        std::allocator<T>().deallocate(p, n);
     }
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U>&) const noexcept { return true; }
+
+private:
+    static std::size_t roundUp(std::size_t bytes) { return (bytes + hugePageSize - 1) & ~(hugePageSize - 1); }
 };
 
-class SJFScheduler : public Scheduler {
-public:
-    void schedule() override {
-        std::sort(processes.begin(), processes.end(), 
-                  [](const Process& a, const Process& b) { return a.arrivalTime < b.arrivalTime; });
+template <typename T>
+using HugePageVector = std::vector<T, HugePageAllocator<T>>;
 
-        int currentTime = 0;
-        size_t completed = 0;
-        auto cmp = [](const Process* a, const Process* b) { return a->burstTime > b->burstTime; };
-        std::priority_queue<Process*, std::vector<Process*>, decltype(cmp)> pq(cmp);
+// The immutable part of a Process. Schedulers share one arrival-ordered table
+// of these and keep only the fields a run changes in their own columns.
+struct ProcessInput {
+    int id;
+    int arrivalTime;
+    int burstTime;
+    int priority;
+};
 
-        size_t i = 0;
-        while (completed < processes.size()) {
-            for (; i < processes.size() && processes[i].arrivalTime <= currentTime; ++i) {
-                pq.push(&processes[i]);
-            }
+using ProcessTable = HugePageVector<ProcessInput>;
 
-            if (pq.empty()) {
-                currentTime = processes[i].arrivalTime;
-                continue;
-            }
+inline bool arrivesBefore(const ProcessInput& a, const ProcessInput& b) {
+    return a.arrivalTime < b.arrivalTime;
+}
 
-            Process* p = pq.top();
-            pq.pop();
+// Restores arrival order after rows were appended from position `from` onwards.
+// Already-ordered batches, the common case for traces, cost a single scan.
+inline void sortByArrival(ProcessTable& table, std::size_t from = 0) {
+    auto mid = table.begin() + from;
+    if (!std::is_sorted(mid, table.end(), arrivesBefore)) {
+        std::stable_sort(mid, table.end(), arrivesBefore);
+    }
+    if (mid != table.begin() && mid != table.end() && arrivesBefore(*mid, *(mid - 1))) {
+        std::inplace_merge(table.begin(), mid, table.end(), arrivesBefore);
+    }
+}
 
-            if (p->responseTime == -1) {
-                p->responseTime = currentTime - p->arrivalTime;
-            }
+inline std::shared_ptr<const ProcessTable> makeProcessTable(std::span<const Process> processes) {
+    auto table = std::make_shared<ProcessTable>();
+    table->reserve(processes.size());
+    for (const auto& p : processes) {
+        table->push_back({p.id, p.arrivalTime, p.burstTime, p.priority});
+    }
+    sortByArrival(*table);
+    return table;
+}
 
-            p->completionTime = currentTime + p->burstTime;
-            p->turnaroundTime = p->completionTime - p->arrivalTime;
-            p->waitingTime = p->turnaroundTime - p->burstTime;
-            currentTime = p->completionTime;
+// Live metrics over fixed-length windows of simulated time, fed as processes
+// complete. Each window closes once a completion lands past its end, or on
+// flush(), and is passed to the sink. Empty windows are reported too. Waiting
+// times go into a log-linear histogram with a fixed bucket count, so memory
+// stays constant however many processes fall in a window. Reported p99 is
+// exact below 64 and otherwise the upper edge of its bucket (within 1/32).
+struct WindowStats {
+    int windowStart;
+    int windowEnd;
+    std::size_t completed;
+    double throughput;
+    double meanWaitingTime;
+    int p99WaitingTime;
+};
 
-            completed++;
+class WindowedMetrics {
+public:
+    using Sink = std::function<void(const WindowStats&)>;
+
+private:
+    static constexpr int linearBuckets = 64;
+    static constexpr int subBucketBits = 5;
+    static constexpr int bucketCount = linearBuckets + (31 - 6) * (1 << subBucketBits);
+
+    int windowLength;
+    Sink sink;
+    int windowStart = 0;
+    std::size_t completed = 0;
+    long long totalWaiting = 0;
+    std::array<std::uint32_t, bucketCount> histogram{};
+
+    static int bucketOf(int v) {
+        if (v < linearBuckets) return std::max(v, 0);
+        int exponent = std::bit_width(static_cast<unsigned>(v)) - 1;
+        int sub = (v >> (exponent - subBucketBits)) & ((1 << subBucketBits) - 1);
+        return linearBuckets + (exponent - 6) * (1 << subBucketBits) + sub;
+    }
+
+    static int bucketUpperEdge(int bucket) {
+        if (bucket < linearBuckets) return bucket;
+        int exponent = (bucket - linearBuckets) / (1 << subBucketBits) + 6;
+        int sub = (bucket - linearBuckets) % (1 << subBucketBits);
+        long long low = (1LL << exponent) + (static_cast<long long>(sub) << (exponent - subBucketBits));
+        return static_cast<int>(std::min<long long>(low + (1LL << (exponent - subBucketBits)) - 1,
+                                                    std::numeric_limits<int>::max()));
+    }
+
+    int percentile(double q) const {
+        std::size_t rank = static_cast<std::size_t>(std::ceil(q * completed));
+        std::size_t seen = 0;
+        for (int b = 0; b < bucketCount; ++b) {
+            seen += histogram[b];
+            if (seen >= rank && seen > 0) return bucketUpperEdge(b);
         }
-        calculateMetrics();
+        return 0;
     }
 
-    void printResults() override {
-        std::cout << "SJF Scheduling Results:\n";
-        Scheduler::printResults();
+    void closeWindow() {
+        WindowStats stats{windowStart, windowStart + windowLength, completed,
+                          static_cast<double>(completed) / windowLength,
+                          completed ? static_cast<double>(totalWaiting) / completed : 0.0,
+                          completed ? percentile(0.99) : 0};
+        if (sink) sink(stats);
+        windowStart += windowLength;
+        completed = 0;
+        totalWaiting = 0;
+        histogram.fill(0);
     }
-};
 
-class SRTFScheduler : public Scheduler {
 public:
-    void schedule() override {
-        auto cmp = [](const Process* a, const Process* b) { return a->remainingTime > b->remainingTime; };
-        std::priority_queue<Process*, std::vector<Process*>, decltype(cmp)> pq(cmp);
+    WindowedMetrics(int windowLength, Sink sink) : windowLength(std::max(windowLength, 1)), sink(std::move(sink)) {}
 
-        std::sort(processes.begin(), processes.end(), 
-                  [](const Process& a, const Process& b) { return a.arrivalTime < b.arrivalTime; });
-
-        int currentTime = 0;
-        size_t completed = 0;
-        size_t i = 0;
+    // Completions must arrive in time order; a late one counts towards the open window.
+    void record(int completionTime, int waitingTime) {
+        while (completionTime >= windowStart + windowLength) {
+            closeWindow();
+        }
+        completed++;
+        totalWaiting += waitingTime;
+        histogram[bucketOf(waitingTime)]++;
+    }
 
-        while (completed < processes.size()) {
-            for (; i < processes.size() && processes[i].arrivalTime <= currentTime; ++i) {
-                pq.push(&processes[i]);
-            }
+    // Emits the open window if it saw any completion, then starts over at time 0.
+    void flush() {
+        if (completed > 0) closeWindow();
+        windowStart = 0;
+        completed = 0;
+        totalWaiting = 0;
+        histogram.fill(0);
+    }
+};
 
-            if (pq.empty()) {
-                currentTime = processes[i].arrivalTime;
-                continue;
-            }
+// Busy and idle time of one CPU over a run. Idle gaps are also counted in
+// power-of-two length classes: gapLengths[b] holds gaps of length [2^b, 2^(b+1)).
+struct CpuUsage {
+    long long busyTime = 0;
+    long long idleTime = 0;
+    std::size_t idleGaps = 0;
+    int longestIdleGap = 0;
+    std::array<std::size_t, 32> gapLengths{};
 
-            Process* p = pq.top();
-            pq.pop();
+    double utilization() const {
+        long long total = busyTime + idleTime;
+        return total > 0 ? static_cast<double>(busyTime) / total : 0.0;
+    }
 
-            if (p->responseTime == -1) {
-                p->responseTime = currentTime - p->arrivalTime;
-            } 
+    double meanIdleGap() const {
+        return idleGaps > 0 ? static_cast<double>(idleTime) / idleGaps : 0.0;
+    }
+};
 
-            int executionTime = (i < processes.size()) ? 
-                std::min(p->remainingTime, processes[i].arrivalTime - currentTime) : 
-                p->remainingTime;
+// Warm-up detection with MSER-5: waiting times, in completion order, are
+// averaged in batches of 5, and the truncation point is the batch d, within the
+// first half, that minimises the variance of the remaining batch means over
+// (m - d)^2. With a relative precision set, record() also reports convergence:
+// the remaining data is split into 20 batches, and the 95% confidence
+// half-width of their mean must be within that fraction of the mean.
+class SteadyStateDetector {
+private:
+    static constexpr std::size_t batchSize = 5;
+    static constexpr std::size_t confidenceBatches = 20;
+    static constexpr double tQuantile = 2.093;  // Student t, 19 degrees of freedom, 97.5%.
 
-            p->remainingTime -= executionTime;
-            currentTime += executionTime;
+    double relativePrecision;
+    std::size_t minObservations;
+    std::vector<double> batchMeans;
+    double pendingSum = 0;
+    std::size_t pendingCount = 0;
+    std::size_t observations = 0;
+    std::size_t nextCheck = 0;
+    bool isConverged = false;
 
-            if (p->remainingTime == 0) {
-                p->completionTime = currentTime;
-                p->turnaroundTime = p->completionTime - p->arrivalTime;
-                p->waitingTime = p->turnaroundTime - p->burstTime;
-                completed++;
-            } else {
-                pq.push(p);
+    // Truncation point in batches.
+    std::size_t mserTruncation() const {
+        std::size_t m = batchMeans.size();
+        if (m < 2) return 0;
+        double sum = 0;
+        double sumSquares = 0;
+        double best = std::numeric_limits<double>::infinity();
+        std::size_t bestD = 0;
+        for (std::size_t d = m; d-- > 0;) {
+            sum += batchMeans[d];
+            sumSquares += batchMeans[d] * batchMeans[d];
+            if (d <= m / 2) {
+                double n = static_cast<double>(m - d);
+                double statistic = std::max(sumSquares - sum * sum / n, 0.0) / (n * n);
+                if (statistic <= best) {
+                    best = statistic;
+                    bestD = d;
+                }
             }
         }
-        calculateMetrics();
+        return bestD;
     }
 
-    void printResults() override {
-        std::cout << "SRTF Scheduling Results:\n";
-        Scheduler::printResults();
+    bool checkConvergence() const {
+        std::size_t d = mserTruncation();
+        std::size_t group = (batchMeans.size() - d) / confidenceBatches;
+        if (group == 0) return false;
+        std::array<double, confidenceBatches> means{};
+        double total = 0;
+        for (std::size_t g = 0; g < confidenceBatches; ++g) {
+            auto first = batchMeans.begin() + d + g * group;
+            means[g] = std::accumulate(first, first + group, 0.0) / group;
+            total += means[g];
+        }
+        double mean = total / confidenceBatches;
+        double variance = 0;
+        for (double x : means) variance += (x - mean) * (x - mean);
+        variance /= confidenceBatches - 1;
+        double halfWidth = tQuantile * std::sqrt(variance / confidenceBatches);
+        return halfWidth <= relativePrecision * std::abs(mean);
+    }
+
+public:
+    // A precision of 0 only truncates and never stops the run early.
+    explicit SteadyStateDetector(double relativePrecision = 0, std::size_t minObservations = 1000)
+        : relativePrecision(relativePrecision), minObservations(std::max(minObservations, batchSize * confidenceBatches)) {
+        clear();
+    }
+
+    void clear() {
+        batchMeans.clear();
+        pendingSum = 0;
+        pendingCount = 0;
+        observations = 0;
+        nextCheck = minObservations;
+        isConverged = false;
+    }
+
+    // Returns true once the steady-state mean has converged.
+    bool record(double waitingTime) {
+        observations++;
+        pendingSum += waitingTime;
+        if (++pendingCount == batchSize) {
+            batchMeans.push_back(pendingSum / batchSize);
+            pendingSum = 0;
+            pendingCount = 0;
+        }
+        // Checks grow geometrically, so the O(m) test stays amortised O(1).
+        if (relativePrecision > 0 && !isConverged && observations >= nextCheck) {
+            isConverged = checkConvergence();
+            nextCheck = observations + observations / 10 + 1;
+        }
+        return isConverged;
     }
+
+    bool converged() const { return isConverged; }
+
+    std::size_t warmupObservations() const { return mserTruncation() * batchSize; }
 };
 
-class RoundRobinScheduler : public Scheduler {
+// Implicit interval tree in the layout of cgranges: half-open intervals sorted by
+// start sit in one array. The node at index i sits at the level given by the
+// trailing one bits of i and also keeps the largest end in its subtree, so an
+// overlap query costs O(log n + k) with no pointers.
+class IntervalIndex {
+public:
+    struct Interval {
+        int start;
+        int end;
+        int maxEnd;
+        std::uint32_t value;
+    };
+
 private:
-    int timeQuantum;
+    std::vector<Interval> items;
+    int rootLevel = -1;
 
 public:
-    RoundRobinScheduler(int quantum) : timeQuantum(quantum) {}
+    void clear() {
+        items.clear();
+        rootLevel = -1;
+    }
 
-    void schedule() override {
-        std::queue<Process*> readyQueue;
-        int currentTime = 0;
-        size_t completed = 0;
-        size_t i = 0;
+    std::size_t size() const { return items.size(); }
+
+    // An interval that continues the last one added with the same value extends it.
+    void add(int start, int end, std::uint32_t value) {
+        if (!items.empty() && items.back().value == value && items.back().end == start) {
+            items.back().end = end;
+        } else {
+            items.push_back({start, end, end, value});
+        }
+    }
+
+    void build() {
+        auto byStart = [](const Interval& a, const Interval& b) { return a.start < b.start; };
+        if (!std::is_sorted(items.begin(), items.end(), byStart)) {
+            std::sort(items.begin(), items.end(), byStart);
+        }
+        const std::int64_t n = static_cast<std::int64_t>(items.size());
+        rootLevel = -1;
+        if (n == 0) return;
 
-        while (completed < processes.size()) {
-            for (; i < processes.size() && processes[i].arrivalTime <= currentTime; ++i) {
-                readyQueue.push(&processes[i]);
+        std::int64_t lastI = 0;
+        int last = 0;
+        for (std::int64_t i = 0; i < n; i += 2) {
+            lastI = i;
+            last = items[i].maxEnd = items[i].end;
+        }
+        int k = 1;
+        for (; std::int64_t{1} << k <= n; ++k) {
+            std::int64_t x = std::int64_t{1} << (k - 1);
+            for (std::int64_t i = (x << 1) - 1; i < n; i += x << 2) {
+                int left = items[i - x].maxEnd;
+                int right = i + x < n ? items[i + x].maxEnd : last;
+                items[i].maxEnd = std::max({items[i].end, left, right});
             }
+            lastI = (lastI >> k & 1) ? lastI - x : lastI + x;
+            if (lastI < n) last = std::max(last, items[lastI].maxEnd);
+        }
+        rootLevel = k - 1;
+    }
 
-            if (readyQueue.empty()) {
-                currentTime = processes[i].arrivalTime;
-                continue;
+    // Calls visit with every interval overlapping [from, to).
+    template <typename Visit>
+    void overlapping(int from, int to, Visit visit) const {
+        if (rootLevel < 0) return;
+        const std::int64_t n = static_cast<std::int64_t>(items.size());
+        struct Frame {
+            std::int64_t x;
+            int level;
+            bool leftDone;
+        };
+        std::array<Frame, 64> stack;
+        int top = 0;
+        stack[top++] = {(std::int64_t{1} << rootLevel) - 1, rootLevel, false};
+        while (top > 0) {
+            Frame f = stack[--top];
+            if (f.level <= 3) {
+                // Small subtrees are cheaper to scan in order.
+                std::int64_t i = f.x >> f.level << f.level;
+                std::int64_t end = std::min(i + (std::int64_t{1} << (f.level + 1)) - 1, n);
+                for (; i < end && items[i].start < to; ++i) {
+                    if (from < items[i].end) visit(items[i]);
+                }
+            } else if (!f.leftDone) {
+                std::int64_t left = f.x - (std::int64_t{1} << (f.level - 1));
+                stack[top++] = {f.x, f.level, true};
+                if (left >= n || items[left].maxEnd > from) stack[top++] = {left, f.level - 1, false};
+            } else if (f.x < n && items[f.x].start < to) {
+                if (from < items[f.x].end) visit(items[f.x]);
+                stack[top++] = {f.x + (std::int64_t{1} << (f.level - 1)), f.level - 1, false};
             }
+        }
+    }
+};
 
-            Process* p = readyQueue.front();
-            readyQueue.pop();
+// The run segments of a schedule, one index per CPU, and the lifetime of each
+// completed process from arrival to completion, for asking what was running
+// or queued at a given time. Attach it with Scheduler::setTimeline(); it is
+// indexed when the run ends. Processes are reported as rows in arrival order.
+class Timeline {
+private:
+    std::vector<IntervalIndex> runs;
+    IntervalIndex lifetimes;
 
-            if (p->responseTime == -1) {
-                p->responseTime = currentTime - p->arrivalTime;
-            }
+public:
+    void clear(std::size_t cpus) {
+        runs.resize(cpus);
+        for (auto& cpu : runs) cpu.clear();
+        lifetimes.clear();
+    }
 
-            int executionTime = std::min(timeQuantum, p->remainingTime);
-            p->remainingTime -= executionTime;
-            currentTime += executionTime;
+    void recordRun(std::size_t p, int start, int end, std::size_t cpu) {
+        if (end > start) runs[cpu].add(start, end, static_cast<std::uint32_t>(p));
+    }
 
-            for (; i < processes.size() && processes[i].arrivalTime <= currentTime; ++i) {
-                readyQueue.push(&processes[i]);
-            }
+    void recordLifetime(std::size_t p, int arrival, int completion) {
+        if (completion > arrival) lifetimes.add(arrival, completion, static_cast<std::uint32_t>(p));
+    }
 
-            if (p->remainingTime > 0) {
-                readyQueue.push(p);
-            } else {
-                p->completionTime = currentTime;
-                p->turnaroundTime = p->completionTime - p->arrivalTime;
-                p->waitingTime = p->turnaroundTime - p->burstTime;
-                completed++;
-            }
+    void build() {
+        for (auto& cpu : runs) cpu.build();
+        lifetimes.build();
+    }
+
+    std::size_t segments() const {
+        std::size_t total = 0;
+        for (const auto& cpu : runs) total += cpu.size();
+        return total;
+    }
+
+    std::optional<std::size_t> runningAt(int time, std::size_t cpu = 0) const {
+        std::optional<std::size_t> running;
+        runs[cpu].overlapping(time, time + 1, [&](const IntervalIndex::Interval& r) { running = r.value; });
+        return running;
+    }
+
+    // Arrived and not yet completed at time, but not running on any CPU.
+    std::vector<std::size_t> queuedAt(int time) const {
+        std::vector<std::size_t> running;
+        for (std::size_t cpu = 0; cpu < runs.size(); ++cpu) {
+            if (auto p = runningAt(time, cpu)) running.push_back(*p);
         }
-        calculateMetrics();
+        std::vector<std::size_t> queued;
+        lifetimes.overlapping(time, time + 1, [&](const IntervalIndex::Interval& l) {
+            if (std::find(running.begin(), running.end(), l.value) == running.end()) queued.push_back(l.value);
+        });
+        std::sort(queued.begin(), queued.end());
+        return queued;
     }
 
-    void printResults() override {
-        std::cout << "Round Robin (Time Quantum: " << timeQuantum << ") Scheduling Results:\n";
-        Scheduler::printResults();
+    // Processes that held some CPU during [from, to).
+    std::vector<std::size_t> ranDuring(int from, int to) const {
+        std::vector<std::size_t> ran;
+        for (const auto& cpu : runs) {
+            cpu.overlapping(from, to, [&](const IntervalIndex::Interval& r) { ran.push_back(r.value); });
+        }
+        std::sort(ran.begin(), ran.end());
+        ran.erase(std::unique(ran.begin(), ran.end()), ran.end());
+        return ran;
     }
 };
 
-class PriorityScheduler : public Scheduler {
-public:  
-    void schedule() override {
-        auto cmp = [](const Process* a, const Process* b) { return a->priority < b->priority; };
-        std::priority_queue<Process*, std::vector<Process*>, decltype(cmp)> pq(cmp);
+using ReadyStorage = HugePageVector<std::size_t>;
 
-        std::sort(processes.begin(), processes.end(), 
-                  [](const Process& a, const Process& b) { return a.arrivalTime < b.arrivalTime; });
+// Ready queues over storage owned by the scheduler, so reruns reuse its capacity.
+template <typename Compare>
+class ReadyHeap {
+private:
+    ReadyStorage& heap;
+    Compare cmp;
 
-        int currentTime = 0;
-        size_t completed = 0;
-        size_t i = 0;
+public:
+    ReadyHeap(ReadyStorage& storage, Compare cmp) : heap(storage), cmp(cmp) {
+        heap.clear();
+    }
 
-        while (completed < processes.size()) {
-            for (; i < processes.size() && processes[i].arrivalTime <= currentTime; ++i) {
-                pq.push(&processes[i]);
-            }
+    bool empty() const { return heap.empty(); }
+    std::size_t top() const { return heap.front(); }
 
-            if (pq.empty()) {
-                currentTime = processes[i].arrivalTime;
-                continue;
-            }
+    void push(std::size_t p) {
+        heap.push_back(p);
+        std::push_heap(heap.begin(), heap.end(), cmp);
+    }
 
-            Process* p = pq.top();
-            pq.pop();
+    void pop() {
+        std::pop_heap(heap.begin(), heap.end(), cmp);
+        heap.pop_back();
+    }
+};
 
-            if (p->responseTime == -1) {
-                p->responseTime = currentTime - p->arrivalTime;
-            }
+class ReadyFifo {
+private:
+    ReadyStorage& ring;
+    std::size_t head = 0;
+    std::size_t queued = 0;
 
-            p->completionTime = currentTime + p->burstTime;
-            p->turnaroundTime = p->completionTime - p->arrivalTime;
-            p->waitingTime = p->turnaroundTime - p->burstTime;
-            currentTime = p->completionTime;
+public:
+    // Each process is queued at most once, so capacity is the process count.
+    ReadyFifo(ReadyStorage& storage, std::size_t capacity) : ring(storage) {
+        ring.resize(capacity);
+    }
 
-            completed++;
-        }
-        calculateMetrics();
+    bool empty() const { return queued == 0; }
+    std::size_t front() const { return ring[head]; }
+
+    void push(std::size_t p) {
+        ring[(head + queued++) % ring.size()] = p;
     }
 
-    void printResults() override {
-        std::cout << "Priority Scheduling Results:\n";
-        Scheduler::printResults();
+    void pop() {
+        head = (head + 1) % ring.size();
+        queued--;
     }
 };
 
+// Binary heaps through a comparator look up both processes' keys on every
+// comparison. The d-ary heaps hold the key inline instead: each entry is one
+// 64-bit word, the key (biased to unsigned) above a 32-bit process index, so
+// a comparison is a single integer compare and ties go to arrival order. The
+// D children of a node sit together, aligned to D entries, which is one cache
+// line for D = 8.
+enum class ReadyHeapKind { Binary, FourAry, EightAry };
+
+using ReadyEntries = HugePageVector<std::uint64_t>;
+
+template <unsigned Arity, typename KeyOf>
+class DaryHeap {
+private:
+    static constexpr std::size_t offset = Arity - 1;  // Root slot, so child groups start at multiples of Arity.
+
+    ReadyEntries& heap;
+    KeyOf keyOf;
+    std::size_t count = 0;
+
+    static std::uint64_t entry(int key, std::size_t p) {
+        return std::uint64_t{static_cast<std::uint32_t>(key) ^ 0x80000000u} << 32 | static_cast<std::uint32_t>(p);
+    }
 
-class PreemptivePriorityScheduler : public Scheduler {
 public:
-    void schedule() override {
-        auto cmp = [](const Process* a, const Process* b) { return a->priority > b->priority; };
-        std::priority_queue<Process*, std::vector<Process*>, decltype(cmp)> pq(cmp);
+    DaryHeap(ReadyEntries& storage, KeyOf keyOf) : heap(storage), keyOf(keyOf) {
+        heap.resize(offset);
+    }
 
-        std::sort(processes.begin(), processes.end(), 
-                  [](const Process& a, const Process& b) { return a.arrivalTime < b.arrivalTime; });
+    bool empty() const { return count == 0; }
+    std::size_t top() const { return static_cast<std::uint32_t>(heap[offset]); }
 
-        int currentTime = 0;
-        size_t completed = 0;
-        size_t i = 0;
+    void push(std::size_t p) {
+        std::uint64_t e = entry(keyOf(p), p);
+        std::size_t i = count++;
+        heap.resize(offset + count);
+        while (i > 0) {
+            std::size_t parent = (i - 1) / Arity;
+            if (heap[offset + parent] <= e) break;
+            heap[offset + i] = heap[offset + parent];
+            i = parent;
+        }
+        heap[offset + i] = e;
+    }
 
-        while (completed < processes.size()) {
-            for (; i < processes.size() && processes[i].arrivalTime <= currentTime; ++i) {
-                pq.push(&processes[i]);
+    void pop() {
+        std::uint64_t e = heap[offset + --count];
+        heap.pop_back();
+        if (count == 0) return;
+        std::uint64_t* nodes = heap.data() + offset;
+        std::size_t i = 0;
+        for (;;) {
+            std::size_t first = i * Arity + 1;
+            if (first >= count) break;
+            std::size_t last = std::min(first + Arity, count);
+            std::size_t best = first;
+            for (std::size_t c = first + 1; c < last; ++c) {
+                if (nodes[c] < nodes[best]) best = c;
             }
+            if (nodes[best] >= e) break;
+            nodes[i] = nodes[best];
+            i = best;
+        }
+        nodes[i] = e;
+    }
+};
 
-            if (pq.empty()) {
-                currentTime = processes[i].arrivalTime;
-                continue;
-            }
+// Keys known to lie in [lowest, highest].
+struct KeyRange {
+    int lowest = std::numeric_limits<int>::min();
+    int highest = std::numeric_limits<int>::max();
+};
 
-            Process* p = pq.top();
-            pq.pop();
+using ReadyLinks = HugePageVector<std::uint32_t>;
 
-            if (p->responseTime == -1) {
-                p->responseTime = currentTime - p->arrivalTime;
-            }
+// O(1) ready queue for keys in a small range, as in the Linux O(1) scheduler:
+// a FIFO per key level, linked through the processes, and a two-level bitmap
+// whose lowest set bit is the lowest non-empty level. Within a level processes
+// leave in arrival order, provided each push is either earlier than the level's
+// head (a preempted or re-admitted process) or later than its tail (a new
+// arrival), which holds for every scheduler loop here.
+template <typename KeyOf>
+class PriorityArray {
+public:
+    static constexpr std::size_t maxLevels = 64 * 64;
 
-            int executionTime = (i < processes.size()) ? 
-                std::min(p->remainingTime, processes[i].arrivalTime - currentTime) : 
-                p->remainingTime;
+private:
+    static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
 
-            p->remainingTime -= executionTime;
-            currentTime += executionTime;
+    ReadyLinks& next;
+    KeyOf keyOf;
+    int lowest;
+    std::uint64_t summary = 0;
+    std::array<std::uint64_t, 64> words{};
+    std::array<std::uint32_t, maxLevels> head;
+    std::array<std::uint32_t, maxLevels> tail;
 
-            if (p->remainingTime == 0) {
-                p->completionTime = currentTime;
-                p->turnaroundTime = p->completionTime - p->arrivalTime;
-                p->waitingTime = p->turnaroundTime - p->burstTime;
-                completed++;
-            } else {
-                pq.push(p);
-            }
+    std::size_t firstLevel() const {
+        std::size_t w = std::countr_zero(summary);
+        return w * 64 + std::countr_zero(words[w]);
+    }
+
+public:
+    PriorityArray(ReadyLinks& storage, std::size_t processes, KeyOf keyOf, int lowest)
+        : next(storage), keyOf(keyOf), lowest(lowest) {
+        next.resize(processes);
+    }
+
+    bool empty() const { return summary == 0; }
+    std::size_t top() const { return head[firstLevel()]; }
+
+    void push(std::size_t p) {
+        std::size_t level = static_cast<std::size_t>(keyOf(p) - lowest);
+        std::uint32_t q = static_cast<std::uint32_t>(p);
+        std::uint64_t& word = words[level / 64];
+        std::uint64_t bit = std::uint64_t{1} << level % 64;
+        if (!(word & bit)) {
+            word |= bit;
+            summary |= std::uint64_t{1} << level / 64;
+            head[level] = tail[level] = q;
+            next[q] = none;
+        } else if (q < head[level]) {
+            next[q] = head[level];
+            head[level] = q;
+        } else {
+            next[tail[level]] = q;
+            tail[level] = q;
+            next[q] = none;
         }
-        calculateMetrics();
     }
 
-    void printResults() override {
-        std::cout << "Preemptive Priority Scheduling Results:\n";
-        Scheduler::printResults();
+    void pop() {
+        std::size_t level = firstLevel();
+        head[level] = next[head[level]];
+        if (head[level] == none) {
+            std::uint64_t& word = words[level / 64];
+            word &= ~(std::uint64_t{1} << level % 64);
+            if (word == 0) summary &= ~(std::uint64_t{1} << level / 64);
+        }
     }
 };
 
-int main() {
-    std::vector<Process> processes = {
-        {1, 0, 10, 3},
-        {2, 1, 5, 1},
-        {3, 3, 8, 2},
-        {4, 5, 2, 4},
-        {5, 6, 4, 5}
-    };
+class Scheduler {
+protected:
+    std::shared_ptr<const ProcessTable> input;
+    ProcessTable* ownedInput;  // Non-null while nobody else holds input.
+    mutable bool inputSorted = true;  // False after out-of-order appends to ownedInput.
+    HugePageVector<int> remainingTime;
+    HugePageVector<int> completionTime;
+    HugePageVector<int> responseTime;
+    ReadyStorage readyStorage;
+    ReadyEntries readyEntries;
+    ReadyLinks readyLinks;
+    ReadyHeapKind heapKind = ReadyHeapKind::Binary;
+    bool priorityArrays = true;
+    std::optional<KeyRange> priorities;  // Bounds on input priorities, found on first use.
+    WindowedMetrics* windowedMetrics = nullptr;
+    SteadyStateDetector* steadyState = nullptr;
+    Timeline* timeline = nullptr;
+    std::vector<std::size_t> completionOrder;  // Only kept while steadyState is set.
+    bool stopRequested = false;
+    std::vector<CpuUsage> cpuUsage;
+    double avgWaitingTime;
+    double avgTurnaroundTime;
+    double avgResponseTime;
+    double throughput;
 
-    std::vector<Scheduler*> schedulers = {
-        new FCFSScheduler(),
-        new SJFScheduler(),
-        new SRTFScheduler(),
-        new RoundRobinScheduler(2),
-        new PriorityScheduler()
-    };
+    // Copy-on-write: a table handed out by sharedInput() is never modified.
+    ProcessTable& ownInput(bool keepRows = true) {
+        if (!ownedInput || input.use_count() > 1) {
+            auto table = keepRows ? std::make_shared<ProcessTable>(*input) : std::make_shared<ProcessTable>();
+            ownedInput = table.get();
+            input = std::move(table);
+        } else if (!keepRows) {
+            ownedInput->clear();
+        }
+        return *ownedInput;
+    }
 
-    for (auto scheduler : schedulers) {
-        for (const auto& p : processes) {
-            scheduler->addProcess(p);
+    ProcessTable& mutableInput(bool keepRows = true) {
+        ProcessTable& table = ownInput(keepRows);
+        if (!keepRows) inputSorted = true;
+        clearResults();
+        return table;
+    }
+
+    // Appends are not ordered on the spot; the table is put in arrival order
+    // once, before anything reads it by position.
+    void noteAppended(const ProcessTable& table, std::size_t from) const {
+        if (inputSorted && from < table.size()) {
+            auto start = table.begin() + (from > 0 ? from - 1 : 0);
+            inputSorted = std::is_sorted(start, table.end(), arrivesBefore);
+        }
+    }
+
+    void ensureSorted() const {
+        if (!inputSorted) {
+            sortByArrival(*ownedInput);
+            inputSorted = true;
         }
-        scheduler->schedule();
-        scheduler->printResults();
-        std::cout << std::string(50, '-') << std::endl;
     }
 
-    // Clean up
-    for (auto scheduler : schedulers) {
-        delete scheduler;
+    void clearResults() {
+        priorities.reset();
+        remainingTime.clear();
+        completionTime.clear();
+        responseTime.clear();
+    }
+
+    // Sizes the result columns for a run; remainingTime only for preemptive policies.
+    void beginRun(bool tracksRemainingTime = false, std::size_t cpus = 1) {
+        ensureSorted();
+        const ProcessTable& in = *input;
+        stopRequested = false;
+        cpuUsage.assign(cpus, CpuUsage{});
+        if (timeline) {
+            timeline->clear(cpus);
+        }
+        completionOrder.clear();
+        if (steadyState) {
+            steadyState->clear();
+            completionOrder.reserve(in.size());
+        }
+        completionTime.assign(in.size(), -1);
+        responseTime.assign(in.size(), -1);
+        remainingTime.clear();
+        if (tracksRemainingTime) {
+            remainingTime.reserve(in.size());
+            for (const auto& p : in) {
+                remainingTime.push_back(p.burstTime);
+            }
+        }
+    }
+
+    void recordRun(std::size_t p, int start, int end, std::size_t cpu = 0) {
+        cpuUsage[cpu].busyTime += end - start;
+        if (timeline) {
+            timeline->recordRun(p, start, end, cpu);
+        }
+    }
+
+    void recordIdle(int from, int to, std::size_t cpu = 0) {
+        if (to <= from) return;
+        CpuUsage& usage = cpuUsage[cpu];
+        int gap = to - from;
+        usage.idleTime += gap;
+        usage.idleGaps++;
+        usage.longestIdleGap = std::max(usage.longestIdleGap, gap);
+        usage.gapLengths[std::bit_width(static_cast<unsigned>(gap)) - 1]++;
+    }
+
+    // Takes back a gap recorded by recordIdle. Returns false if it may have been
+    // the longest gap, which the caller then has to recompute.
+    bool forgetIdle(int from, int to, std::size_t cpu = 0) {
+        if (to <= from) return true;
+        CpuUsage& usage = cpuUsage[cpu];
+        int gap = to - from;
+        usage.idleTime -= gap;
+        usage.idleGaps--;
+        usage.gapLengths[std::bit_width(static_cast<unsigned>(gap)) - 1]--;
+        return gap < usage.longestIdleGap;
+    }
+
+    KeyRange priorityRange() {
+        if (!priorities) {
+            KeyRange range{std::numeric_limits<int>::max(), std::numeric_limits<int>::min()};
+            for (const auto& p : *input) {
+                range.lowest = std::min(range.lowest, p.priority);
+                range.highest = std::max(range.highest, p.priority);
+            }
+            priorities = range;
+        }
+        return *priorities;
+    }
+
+    // Calls body with the ready queue chosen by setReadyHeap(), ordered by
+    // keyOf(p), lowest first, then by arrival order. Keys within a range of
+    // PriorityArray::maxLevels use a priority array instead. Both alternatives
+    // index processes with 32 bits, so larger tables use the binary heap.
+    template <typename KeyOf, typename Body>
+    void withReadyHeap(KeyOf keyOf, Body body, KeyRange keys = {}) {
+        const bool indexable = input->size() < std::numeric_limits<std::uint32_t>::max();
+        if (indexable && priorityArrays &&
+            static_cast<long long>(keys.highest) - keys.lowest < static_cast<long long>(PriorityArray<KeyOf>::maxLevels)) {
+            PriorityArray<KeyOf> pq(readyLinks, input->size(), keyOf, keys.lowest);
+            body(pq);
+            return;
+        }
+        switch (indexable ? heapKind : ReadyHeapKind::Binary) {
+        case ReadyHeapKind::FourAry: {
+            DaryHeap<4, KeyOf> pq(readyEntries, keyOf);
+            body(pq);
+            return;
+        }
+        case ReadyHeapKind::EightAry: {
+            DaryHeap<8, KeyOf> pq(readyEntries, keyOf);
+            body(pq);
+            return;
+        }
+        case ReadyHeapKind::Binary:
+            break;
+        }
+        ReadyHeap pq(readyStorage, [keyOf](std::size_t a, std::size_t b) {
+            auto x = keyOf(a);
+            auto y = keyOf(b);
+            return x != y ? x > y : a > b;
+        });
+        body(pq);
+    }
+
+    // Brings the results up to date after updateProcess changed row k; policies
+    // without an incremental path run again.
+    virtual void reschedule(std::size_t, int) { schedule(); }
+
+    void complete(std::size_t p, int time) {
+        completionTime[p] = time;
+        if (timeline) {
+            timeline->recordLifetime(p, (*input)[p].arrivalTime, time);
+        }
+        if (windowedMetrics) {
+            const ProcessInput& in = (*input)[p];
+            windowedMetrics->record(time, time - in.arrivalTime - in.burstTime);
+        }
+        if (steadyState) {
+            const ProcessInput& in = (*input)[p];
+            completionOrder.push_back(p);
+            stopRequested = steadyState->record(time - in.arrivalTime - in.burstTime);
+        }
+    }
+
+    // Averages over completions after the detected warm-up; throughput is
+    // measured from the end of the warm-up to the last completion.
+    ScheduleMetrics steadyStateMetrics() const {
+        std::size_t warmup = std::min(steadyState->warmupObservations(), completionOrder.size());
+        auto kept = std::span<const std::size_t>(completionOrder).subspan(warmup);
+        ScheduleMetrics m = computeMetrics(kept | std::views::transform([this](std::size_t k) { return result(k); }));
+        int warmupEnd = warmup > 0 ? completionTime[completionOrder[warmup - 1]] : 0;
+        int lastCompletion = kept.empty() ? warmupEnd : completionTime[kept.back()];
+        m.throughput = lastCompletion > warmupEnd ? kept.size() / static_cast<double>(lastCompletion - warmupEnd) : 0.0;
+        return m;
+    }
+
+    void endRun() {
+        if (windowedMetrics) {
+            windowedMetrics->flush();
+        }
+        if (timeline) {
+            timeline->build();
+        }
+        calculateMetrics();
+    }
+
+public:
+    Scheduler() {
+        auto table = std::make_shared<ProcessTable>();
+        ownedInput = table.get();
+        input = std::move(table);
+    }
+
+    virtual ~Scheduler() = default;
+
+    // Loading is an amortized O(1) append per process, in any order; the
+    // table is stably sorted by arrival once, on the next run or read.
+    void addProcess(const Process& p) {
+        ProcessTable& table = mutableInput();
+        table.push_back({p.id, p.arrivalTime, p.burstTime, p.priority});
+        noteAppended(table, table.size() - 1);
+    }
+
+    // Bulk loading: one copy of the batch and one scan to see if it is in order.
+    void addProcesses(std::span<const Process> processes) {
+        ProcessTable& table = mutableInput();
+        std::size_t from = table.size();
+        // Grow geometrically, so many small batches stay linear overall.
+        if (table.capacity() < from + processes.size()) {
+            table.reserve(std::max(from + processes.size(), 2 * table.capacity()));
+        }
+        for (const auto& p : processes) {
+            table.push_back({p.id, p.arrivalTime, p.burstTime, p.priority});
+        }
+        noteAppended(table, from);
+    }
+
+    // Process records carry per-run fields the table does not keep, so this
+    // converts in one pass and releases the caller's buffer straight away.
+    void addProcesses(std::vector<Process>&& processes) {
+        addProcesses(std::span<const Process>(processes));
+        std::vector<Process>().swap(processes);
+    }
+
+    // Rows are adopted without copying when this scheduler has no input yet.
+    void addProcesses(ProcessTable&& rows) {
+        if (input->empty()) {
+            clearResults();
+            auto table = std::make_shared<ProcessTable>(std::move(rows));
+            sortByArrival(*table);
+            ownedInput = table.get();
+            input = std::move(table);
+            return;
+        }
+        ProcessTable& table = mutableInput();
+        std::size_t from = table.size();
+        table.insert(table.end(), rows.begin(), rows.end());
+        noteAppended(table, from);
+    }
+
+    // Capacity hint for the input table and the per-run columns.
+    void reserve(std::size_t n) {
+        mutableInput().reserve(n);
+        completionTime.reserve(n);
+        responseTime.reserve(n);
+        readyStorage.reserve(n);
+    }
+
+    // Shares an input table with other schedulers; unordered tables are copied and sorted.
+    void setInput(std::shared_ptr<const ProcessTable> table) {
+        clearResults();
+        inputSorted = true;
+        if (std::is_sorted(table->begin(), table->end(), arrivesBefore)) {
+            input = std::move(table);
+            ownedInput = nullptr;
+        } else {
+            auto sorted = std::make_shared<ProcessTable>(*table);
+            sortByArrival(*sorted);
+            ownedInput = sorted.get();
+            input = std::move(sorted);
+        }
+    }
+
+    std::shared_ptr<const ProcessTable> sharedInput() const {
+        ensureSorted();
+        return input;
+    }
+
+    std::size_t size() const { return input->size(); }
+
+    // Streams per-window metrics while schedule() runs; nullptr detaches.
+    void setWindowedMetrics(WindowedMetrics* metrics) { windowedMetrics = metrics; }
+
+    // Reports metrics without the detected warm-up, and stops schedule() early
+    // once the detector has converged; nullptr detaches. Processes left
+    // unfinished by an early stop have a completion time of -1 in the columns.
+    void setSteadyStateDetector(SteadyStateDetector* detector) { steadyState = detector; }
+
+    // Ready queue for SJF, SRTF, Priority and Preemptive Priority; all kinds
+    // give the same schedule.
+    void setReadyHeap(ReadyHeapKind kind) { heapKind = kind; }
+
+    // Priority and Preemptive Priority dispatch in O(1) from a priority array
+    // when the input's priorities span at most 4096 values; disabling falls
+    // back to the ready heap.
+    void setPriorityArray(bool enabled) { priorityArrays = enabled; }
+
+    // Records run segments and lifetimes for time queries; nullptr detaches.
+    void setTimeline(Timeline* recorder) { timeline = recorder; }
+
+    std::size_t warmupExcluded() const {
+        return steadyState ? std::min(steadyState->warmupObservations(), completionOrder.size()) : 0;
+    }
+
+    // Per-CPU busy and idle accounting of the last run.
+    std::span<const CpuUsage> cpus() const { return cpuUsage; }
+
+    void printCpuUsage() const {
+        std::cout << "CPU\tBusy\tIdle\tUtilization\tIdle Gaps\tMean Gap\tLongest Gap\n";
+        for (std::size_t c = 0; c < cpuUsage.size(); ++c) {
+            const CpuUsage& u = cpuUsage[c];
+            std::cout << c << "\t" << u.busyTime << "\t" << u.idleTime << "\t" << u.utilization() * 100 << "%\t\t"
+                      << u.idleGaps << "\t\t" << u.meanIdleGap() << "\t\t" << u.longestIdleGap << "\n";
+        }
+    }
+
+    std::size_t completedCount() const {
+        return steadyState ? completionOrder.size() : completionTime.size();
+    }
+
+    void clear() { mutableInput(false); }
+
+    ScheduleMetrics metrics() const {
+        return {avgWaitingTime, avgTurnaroundTime, avgResponseTime, throughput};
+    }
+
+    // Raw result columns in arrival order; empty until schedule() has run.
+    std::span<const int> completionTimes() const { return completionTime; }
+    std::span<const int> responseTimes() const { return responseTime; }
+
+    // Assembles the full record of the k-th process in arrival order.
+    Process result(std::size_t k) const {
+        ensureSorted();
+        const ProcessInput& in = (*input)[k];
+        Process p(in.id, in.arrivalTime, in.burstTime, in.priority);
+        if (k < completionTime.size()) {
+            p.responseTime = responseTime[k];
+            if (k < remainingTime.size()) {
+                p.remainingTime = remainingTime[k];
+            }
+            if (completionTime[k] >= 0) {
+                p.remainingTime = 0;
+                p.completionTime = completionTime[k];
+                p.turnaroundTime = p.completionTime - p.arrivalTime;
+                p.waitingTime = p.turnaroundTime - p.burstTime;
+            }
+        }
+        return p;
+    }
+
+    auto results() const {
+        return std::views::iota(std::size_t{0}, size()) |
+               std::views::transform([this](std::size_t k) { return result(k); });
+    }
+
+    virtual void schedule() = 0;
+
+    // What-if analysis: changes the burst and priority of the k-th process in
+    // arrival order and reschedules, incrementally where the policy can.
+    // Returns false if there is no such process.
+    bool updateProcess(std::size_t k, int burstTime, int priority) {
+        if (k >= size()) return false;
+        ensureSorted();
+        ProcessInput& row = ownInput()[k];
+        int previousBurst = std::exchange(row.burstTime, burstTime);
+        row.priority = priority;
+        if (priorities) {
+            priorities->lowest = std::min(priorities->lowest, priority);
+            priorities->highest = std::max(priorities->highest, priority);
+        }
+        reschedule(k, previousBurst);
+        return true;
+    }
+
+    // Discards the previous run's results; the input table is left untouched.
+    void reset() {
+        clearResults();
+        avgWaitingTime = avgTurnaroundTime = avgResponseTime = throughput = 0;
+    }
+
+    void rerun() {
+        reset();
+        schedule();
+    }
+
+    void rerun(std::span<const Process> processes) {
+        mutableInput(false);
+        addProcesses(processes);
+        rerun();
+    }
+    
+    virtual void printResults() {
+        printSchedule(results(), metrics());
+        if (steadyState) {
+            std::cout << "Warm-up excluded: " << warmupExcluded() << " of " << completedCount()
+                      << " completed processes" << std::endl;
+        }
+    }
+
+    // Processes that never completed, such as those on a dependency cycle or
+    // deadlocked on locks, are left out of the averages.
+    void calculateMetrics() {
+        auto finished = std::views::iota(std::size_t{0}, completionTime.size()) |
+                        std::views::filter([this](std::size_t k) { return completionTime[k] >= 0; }) |
+                        std::views::transform([this](std::size_t k) { return result(k); });
+        ScheduleMetrics m = steadyState ? steadyStateMetrics() : computeMetrics(finished);
+        avgWaitingTime = m.avgWaitingTime;
+        avgTurnaroundTime = m.avgTurnaroundTime;
+        avgResponseTime = m.avgResponseTime;
+        throughput = m.throughput;
+    }
+};
+
+// Non-preemptive policies log every dispatch decision, so updateProcess() can
+// re-simulate from the first decision the changed process could affect: the
+// first one taken at or after its arrival. The re-simulation stops as soon as
+// it reaches a decision at the same time and with the same set of processes
+// already dispatched as in the previous run, once the changed process is among
+// them; from there on both runs are identical. Policies break ties by arrival
+// order, so a decision depends only on that state.
+class NonPreemptiveScheduler : public Scheduler {
+protected:
+    std::vector<std::size_t> dispatchOrder;
+    std::vector<int> dispatchTime;
+    std::vector<std::size_t> positionOf;
+    std::vector<int> balance;  // Times in the new dispatched set minus times in the old one.
+    std::vector<std::size_t> touched;
+    long long totalWaiting = 0;
+    long long totalTurnaround = 0;
+    long long totalResponse = 0;
+
+    void beginLog() {
+        dispatchOrder.clear();
+        dispatchTime.clear();
+        dispatchOrder.reserve(input->size());
+        dispatchTime.reserve(input->size());
+        positionOf.resize(input->size());
+        totalWaiting = totalTurnaround = totalResponse = 0;
+    }
+
+    // Runs p to completion from start; returns the completion time.
+    int dispatch(std::size_t p, int start) {
+        const ProcessInput& in = (*input)[p];
+        int end = start + in.burstTime;
+        responseTime[p] = start - in.arrivalTime;
+        recordRun(p, start, end);
+        complete(p, end);
+        positionOf[p] = dispatchOrder.size();
+        dispatchOrder.push_back(p);
+        dispatchTime.push_back(start);
+        totalWaiting += end - in.arrivalTime - in.burstTime;
+        totalTurnaround += end - in.arrivalTime;
+        totalResponse += start - in.arrivalTime;
+        return end;
+    }
+
+    template <typename KeyOf>
+    void simulate(KeyOf keyOf, KeyRange keys = {}) {
+        beginRun();
+        beginLog();
+        const ProcessTable& in = *input;
+
+        withReadyHeap(keyOf, [&](auto& pq) {
+            int currentTime = 0;
+            size_t completed = 0;
+            size_t i = 0;
+            while (completed < in.size() && !stopRequested) {
+                for (; i < in.size() && in[i].arrivalTime <= currentTime; ++i) {
+                    pq.push(i);
+                }
+
+                if (pq.empty()) {
+                    recordIdle(currentTime, in[i].arrivalTime);
+                    currentTime = in[i].arrivalTime;
+                    continue;
+                }
+
+                size_t p = pq.top();
+                pq.pop();
+                currentTime = dispatch(p, currentTime);
+                completed++;
+            }
+        }, keys);
+        endRun();
+    }
+
+    template <typename KeyOf>
+    void resimulate(KeyOf keyOf, std::size_t changed, int previousBurst, KeyRange keys = {}) {
+        const ProcessTable& in = *input;
+        const std::size_t n = in.size();
+        // Monitors need the completions of a whole run, in order.
+        if (steadyState || windowedMetrics || timeline || dispatchOrder.size() != n || completionTime.size() != n) {
+            schedule();
+            return;
+        }
+        if (balance.size() != n) balance.assign(n, 0);
+
+        auto oldBurst = [&](std::size_t p) { return p == changed ? previousBurst : in[p].burstTime; };
+        std::size_t differing = 0;
+        auto shift = [&](std::size_t p, int by) {
+            if (balance[p] == 0) {
+                differing++;
+                touched.push_back(p);
+            }
+            if ((balance[p] += by) == 0) differing--;
+        };
+
+        // Decisions before the changed process arrived are unaffected.
+        std::size_t r = std::lower_bound(dispatchTime.begin(), dispatchTime.end(), in[changed].arrivalTime) - dispatchTime.begin();
+        int currentTime = dispatchTime[r];
+        std::size_t i = std::upper_bound(in.begin(), in.end(), currentTime,
+                                         [](int t, const ProcessInput& q) { return t < q.arrivalTime; }) - in.begin();
+
+        cpuUsage[0].busyTime += in[changed].burstTime - previousBurst;
+        bool longestGapKnown = true;
+        bool changedDispatched = false;
+        int oldPreviousEnd = 0;
+        int newPreviousEnd = 0;
+
+        // Everything dispatched before r has arrived by now, so the ready
+        // queue is the i - r arrived processes at positions r and later.
+        withReadyHeap(keyOf, [&](auto& pq) {
+            for (std::size_t p = i, waiting = i - r; waiting > 0; ) {
+                if (positionOf[--p] >= r) {
+                    pq.push(p);
+                    waiting--;
+                }
+            }
+
+            auto admit = [&] {
+                for (; i < n && in[i].arrivalTime <= currentTime; ++i) {
+                    pq.push(i);
+                }
+            };
+
+            for (std::size_t from = r; r < n; ++r) {
+                admit();
+                if (pq.empty()) {
+                    currentTime = in[i].arrivalTime;
+                    admit();
+                }
+
+                int oldStart = dispatchTime[r];
+                std::size_t oldP = dispatchOrder[r];
+                if (r > from) {
+                    longestGapKnown &= forgetIdle(oldPreviousEnd, oldStart);
+                    recordIdle(newPreviousEnd, currentTime);
+                    if (changedDispatched && currentTime == oldStart && differing == 0) break;
+                }
+
+                size_t p = pq.top();
+                pq.pop();
+                shift(p, 1);
+                shift(oldP, -1);
+                changedDispatched |= p == changed;
+                oldPreviousEnd = oldStart + oldBurst(oldP);
+
+                int end = currentTime + in[p].burstTime;
+                totalTurnaround += end - completionTime[p];
+                totalWaiting += end - completionTime[p] - (in[p].burstTime - oldBurst(p));
+                totalResponse += currentTime - in[p].arrivalTime - responseTime[p];
+                responseTime[p] = currentTime - in[p].arrivalTime;
+                completionTime[p] = end;
+                dispatchOrder[r] = p;
+                dispatchTime[r] = currentTime;
+                positionOf[p] = r;
+                newPreviousEnd = currentTime = end;
+            }
+        }, keys);
+
+        for (std::size_t p : touched) balance[p] = 0;
+        touched.clear();
+
+        if (!longestGapKnown) {
+            int longest = 0;
+            int previousEnd = 0;
+            for (std::size_t k = 0; k < n; ++k) {
+                longest = std::max(longest, dispatchTime[k] - previousEnd);
+                previousEnd = dispatchTime[k] + in[dispatchOrder[k]].burstTime;
+            }
+            cpuUsage[0].longestIdleGap = longest;
+        }
+
+        const double count = static_cast<double>(n);
+        avgWaitingTime = totalWaiting / count;
+        avgTurnaroundTime = totalTurnaround / count;
+        avgResponseTime = totalResponse / count;
+        throughput = count / (dispatchTime[n - 1] + in[dispatchOrder[n - 1]].burstTime);
+    }
+};
+
+class FCFSScheduler : public NonPreemptiveScheduler {
+protected:
+    void reschedule(std::size_t k, int previousBurst) override {
+        resimulate([](size_t) { return 0; }, k, previousBurst);
+    }
+
+public:
+    void schedule() override {
+        beginRun();
+        beginLog();
+        const ProcessTable& in = *input;
+
+        int currentTime = 0;
+        for (std::size_t p = 0; p < in.size() && !stopRequested; ++p) {
+            if (currentTime < in[p].arrivalTime) {
+                recordIdle(currentTime, in[p].arrivalTime);
+                currentTime = in[p].arrivalTime;
+            }
+            currentTime = dispatch(p, currentTime);
+        }
+        endRun();
+    }
+
+    void printResults() override {
+        std::cout << "FCFS Scheduling Results:\n";
+        Scheduler::printResults();
+    }
+};
+
+class SJFScheduler : public NonPreemptiveScheduler {
+private:
+    auto key() const {
+        return [&in = *input](size_t p) { return in[p].burstTime; };
+    }
+
+protected:
+    void reschedule(std::size_t k, int previousBurst) override { resimulate(key(), k, previousBurst); }
+
+public:
+    void schedule() override { simulate(key()); }
+
+    void printResults() override {
+        std::cout << "SJF Scheduling Results:\n";
+        Scheduler::printResults();
+    }
+};
+
+class SRTFScheduler : public Scheduler {
+public:
+    void schedule() override {
+        beginRun(true);
+        const ProcessTable& in = *input;
+
+        withReadyHeap([this](size_t p) { return remainingTime[p]; }, [&](auto& pq) {
+            int currentTime = 0;
+            size_t completed = 0;
+            size_t i = 0;
+
+            while (completed < in.size() && !stopRequested) {
+                for (; i < in.size() && in[i].arrivalTime <= currentTime; ++i) {
+                    pq.push(i);
+                }
+
+                if (pq.empty()) {
+                    recordIdle(currentTime, in[i].arrivalTime);
+                    currentTime = in[i].arrivalTime;
+                    continue;
+                }
+
+                size_t p = pq.top();
+                pq.pop();
+
+                if (responseTime[p] == -1) {
+                    responseTime[p] = currentTime - in[p].arrivalTime;
+                } 
+
+                int executionTime = (i < in.size()) ? 
+                    std::min(remainingTime[p], in[i].arrivalTime - currentTime) : 
+                    remainingTime[p];
+
+                remainingTime[p] -= executionTime;
+                recordRun(p, currentTime, currentTime + executionTime);
+                currentTime += executionTime;
+
+                if (remainingTime[p] == 0) {
+                    complete(p, currentTime);
+                    completed++;
+                } else {
+                    pq.push(p);
+                }
+            }
+        });
+        endRun();
+    }
+
+    void printResults() override {
+        std::cout << "SRTF Scheduling Results:\n";
+        Scheduler::printResults();
+    }
+};
+
+class RoundRobinScheduler : public Scheduler {
+private:
+    int timeQuantum;
+
+public:
+    RoundRobinScheduler(int quantum) : timeQuantum(quantum) {}
+
+    void schedule() override {
+        beginRun(true);
+        const ProcessTable& in = *input;
+
+        ReadyFifo readyQueue(readyStorage, in.size());
+        int currentTime = 0;
+        size_t completed = 0;
+        size_t i = 0;
+
+        while (completed < in.size() && !stopRequested) {
+            for (; i < in.size() && in[i].arrivalTime <= currentTime; ++i) {
+                readyQueue.push(i);
+            }
+
+            if (readyQueue.empty()) {
+                recordIdle(currentTime, in[i].arrivalTime);
+                currentTime = in[i].arrivalTime;
+                continue;
+            }
+
+            size_t p = readyQueue.front();
+            readyQueue.pop();
+
+            if (responseTime[p] == -1) {
+                responseTime[p] = currentTime - in[p].arrivalTime;
+            }
+
+            int executionTime = std::min(timeQuantum, remainingTime[p]);
+            remainingTime[p] -= executionTime;
+            recordRun(p, currentTime, currentTime + executionTime);
+            currentTime += executionTime;
+
+            for (; i < in.size() && in[i].arrivalTime <= currentTime; ++i) {
+                readyQueue.push(i);
+            }
+
+            if (remainingTime[p] > 0) {
+                readyQueue.push(p);
+            } else {
+                complete(p, currentTime);
+                completed++;
+            }
+        }
+        endRun();
+    }
+
+    void printResults() override {
+        std::cout << "Round Robin (Time Quantum: " << timeQuantum << ") Scheduling Results:\n";
+        Scheduler::printResults();
+    }
+};
+
+class PriorityScheduler : public NonPreemptiveScheduler {
+private:
+    auto key() const {
+        // Highest priority first; ~ reverses the order without overflow.
+        return [&in = *input](size_t p) { return ~in[p].priority; };
+    }
+
+    KeyRange keys() {
+        KeyRange range = priorityRange();
+        return {~range.highest, ~range.lowest};
+    }
+
+protected:
+    void reschedule(std::size_t k, int previousBurst) override { resimulate(key(), k, previousBurst, keys()); }
+
+public:
+    void schedule() override { simulate(key(), keys()); }
+
+    void printResults() override {
+        std::cout << "Priority Scheduling Results:\n";
+        Scheduler::printResults();
+    }
+};
+
+
+class PreemptivePriorityScheduler : public Scheduler {
+public:
+    void schedule() override {
+        beginRun(true);
+        const ProcessTable& in = *input;
+
+        withReadyHeap([&in](size_t p) { return in[p].priority; }, [&](auto& pq) {
+            int currentTime = 0;
+            size_t completed = 0;
+            size_t i = 0;
+
+            while (completed < in.size() && !stopRequested) {
+                for (; i < in.size() && in[i].arrivalTime <= currentTime; ++i) {
+                    pq.push(i);
+                }
+
+                if (pq.empty()) {
+                    recordIdle(currentTime, in[i].arrivalTime);
+                    currentTime = in[i].arrivalTime;
+                    continue;
+                }
+
+                size_t p = pq.top();
+                pq.pop();
+
+                if (responseTime[p] == -1) {
+                    responseTime[p] = currentTime - in[p].arrivalTime;
+                }
+
+                int executionTime = (i < in.size()) ? 
+                    std::min(remainingTime[p], in[i].arrivalTime - currentTime) : 
+                    remainingTime[p];
+
+                remainingTime[p] -= executionTime;
+                recordRun(p, currentTime, currentTime + executionTime);
+                currentTime += executionTime;
+
+                if (remainingTime[p] == 0) {
+                    complete(p, currentTime);
+                    completed++;
+                } else {
+                    pq.push(p);
+                }
+            }
+        }, priorityRange());
+        endRun();
+    }
+
+    void printResults() override {
+        std::cout << "Preemptive Priority Scheduling Results:\n";
+        Scheduler::printResults();
+    }
+};
+
+// Burst prediction by exponential averaging, tau' = alpha * t + (1 - alpha) * tau,
+// kept per class of process: one global history (the default), per process id
+// or per priority level. ProcessId only learns when ids recur, as with the
+// repeated bursts of an ftrace import; with unique ids every estimate stays at
+// initialEstimate.
+enum class PredictorClass { Global, ProcessId, Priority };
+
+class BurstPredictor {
+private:
+    double alpha;
+    double initialEstimate;
+    PredictorClass classKey;
+    std::unordered_map<int, double> estimates;
+
+    int keyOf(const ProcessInput& p) const {
+        switch (classKey) {
+        case PredictorClass::ProcessId: return p.id;
+        case PredictorClass::Priority: return p.priority;
+        case PredictorClass::Global: break;
+        }
+        return 0;
+    }
+
+public:
+    explicit BurstPredictor(double alpha = 0.5, double initialEstimate = 10, PredictorClass classKey = PredictorClass::Global)
+        : alpha(std::clamp(alpha, 0.0, 1.0)), initialEstimate(initialEstimate), classKey(classKey) {}
+
+    int predict(const ProcessInput& p) const {
+        auto it = estimates.find(keyOf(p));
+        return static_cast<int>(std::lround(it != estimates.end() ? it->second : initialEstimate));
+    }
+
+    void observe(const ProcessInput& p) {
+        auto [it, inserted] = estimates.try_emplace(keyOf(p), initialEstimate);
+        it->second = alpha * p.burstTime + (1 - alpha) * it->second;
+    }
+
+    void clear() { estimates.clear(); }
+};
+
+// SJF and SRTF scheduled on predicted bursts. A process's estimate is fixed when
+// it arrives, and histories learn only from bursts that have already completed.
+// oracleMetrics() reruns the true-burst policy on the same shared input, and
+// printResults() reports how far the prediction falls behind it.
+template <typename Oracle>
+class PredictiveScheduler : public Scheduler {
+protected:
+    BurstPredictor predictor;
+    std::vector<int> estimate;
+
+    void beginPrediction() {
+        predictor.clear();
+        estimate.assign(input->size(), 0);
+    }
+
+    void admit(std::size_t p) {
+        estimate[p] = predictor.predict((*input)[p]);
+    }
+
+    void completePredicted(std::size_t p, int time) {
+        complete(p, time);
+        predictor.observe((*input)[p]);
+    }
+
+public:
+    explicit PredictiveScheduler(BurstPredictor predictor) : predictor(std::move(predictor)) {}
+
+    ScheduleMetrics oracleMetrics() const {
+        Oracle oracle;
+        oracle.setInput(sharedInput());
+        oracle.schedule();
+        return oracle.metrics();
+    }
+
+    void printDegradation() const {
+        ScheduleMetrics predicted = metrics();
+        ScheduleMetrics oracle = oracleMetrics();
+        auto change = [](double actual, double best) { return best > 0 ? (actual / best - 1) * 100 : 0.0; };
+        std::cout << "Oracle Average Waiting Time: " << oracle.avgWaitingTime << " (predicted is "
+                  << change(predicted.avgWaitingTime, oracle.avgWaitingTime) << "% worse)" << std::endl;
+        std::cout << "Oracle Average Turnaround Time: " << oracle.avgTurnaroundTime << " (predicted is "
+                  << change(predicted.avgTurnaroundTime, oracle.avgTurnaroundTime) << "% worse)" << std::endl;
+    }
+};
+
+class PredictiveSJFScheduler : public PredictiveScheduler<SJFScheduler> {
+public:
+    explicit PredictiveSJFScheduler(BurstPredictor predictor = BurstPredictor())
+        : PredictiveScheduler(std::move(predictor)) {}
+
+    void schedule() override {
+        beginRun();
+        beginPrediction();
+        const ProcessTable& in = *input;
+
+        int currentTime = 0;
+        size_t completed = 0;
+        // Equal estimates run in arrival order, as in SJFScheduler.
+        auto cmp = [this](size_t a, size_t b) { return estimate[a] != estimate[b] ? estimate[a] > estimate[b] : a > b; };
+        ReadyHeap pq(readyStorage, cmp);
+
+        size_t i = 0;
+        while (completed < in.size() && !stopRequested) {
+            for (; i < in.size() && in[i].arrivalTime <= currentTime; ++i) {
+                admit(i);
+                pq.push(i);
+            }
+
+            if (pq.empty()) {
+                recordIdle(currentTime, in[i].arrivalTime);
+                currentTime = in[i].arrivalTime;
+                continue;
+            }
+
+            size_t p = pq.top();
+            pq.pop();
+
+            responseTime[p] = currentTime - in[p].arrivalTime;
+            recordRun(p, currentTime, currentTime + in[p].burstTime);
+            completePredicted(p, currentTime + in[p].burstTime);
+            currentTime = completionTime[p];
+
+            completed++;
+        }
+        endRun();
+    }
+
+    void printResults() override {
+        std::cout << "Predictive SJF Scheduling Results:\n";
+        Scheduler::printResults();
+        printDegradation();
+    }
+};
+
+// Ranks by predicted remaining time, the estimate minus the CPU already used.
+// Processes that overrun their estimate rank as almost done.
+class PredictiveSRTFScheduler : public PredictiveScheduler<SRTFScheduler> {
+public:
+    explicit PredictiveSRTFScheduler(BurstPredictor predictor = BurstPredictor())
+        : PredictiveScheduler(std::move(predictor)) {}
+
+    void schedule() override {
+        beginRun(true);
+        beginPrediction();
+        const ProcessTable& in = *input;
+
+        auto predictedRemaining = [this, &in](size_t p) {
+            return std::max(estimate[p] - (in[p].burstTime - remainingTime[p]), 0);
+        };
+        auto cmp = [&](size_t a, size_t b) {
+            int x = predictedRemaining(a), y = predictedRemaining(b);
+            return x != y ? x > y : a > b;
+        };
+        ReadyHeap pq(readyStorage, cmp);
+
+        int currentTime = 0;
+        size_t completed = 0;
+        size_t i = 0;
+
+        while (completed < in.size() && !stopRequested) {
+            for (; i < in.size() && in[i].arrivalTime <= currentTime; ++i) {
+                admit(i);
+                pq.push(i);
+            }
+
+            if (pq.empty()) {
+                recordIdle(currentTime, in[i].arrivalTime);
+                currentTime = in[i].arrivalTime;
+                continue;
+            }
+
+            size_t p = pq.top();
+            pq.pop();
+
+            if (responseTime[p] == -1) {
+                responseTime[p] = currentTime - in[p].arrivalTime;
+            }
+
+            int executionTime = (i < in.size()) ? 
+                std::min(remainingTime[p], in[i].arrivalTime - currentTime) : 
+                remainingTime[p];
+
+            remainingTime[p] -= executionTime;
+            recordRun(p, currentTime, currentTime + executionTime);
+            currentTime += executionTime;
+
+            if (remainingTime[p] == 0) {
+                completePredicted(p, currentTime);
+                completed++;
+            } else {
+                pq.push(p);
+            }
+        }
+        endRun();
+    }
+
+    void printResults() override {
+        std::cout << "Predictive SRTF Scheduling Results:\n";
+        Scheduler::printResults();
+        printDegradation();
+    }
+};
+
+// Preemptive priority scheduling (lower value runs first) with simulated mutexes.
+// A lock request holds a resource between two offsets into the process's burst.
+// Inheritance lends each waiter's effective priority to the holder, and the
+// holder passes it on when it is blocked itself. Ceiling raises a holder to the
+// highest priority of any process that uses the resource. Each hop of an
+// inheritance chain is a few O(log n) set updates.
+enum class LockProtocol { None, Inheritance, Ceiling };
+
+struct LockRequest {
+    int processId;
+    int resource;
+    int acquireOffset;
+    int releaseOffset;
+};
+
+class ResourceScheduler : public Scheduler {
+private:
+    static constexpr std::size_t unowned = std::numeric_limits<std::size_t>::max();
+
+    struct LockEvent {
+        int offset;
+        bool acquire;
+        std::size_t resource;
+    };
+
+    struct Resource {
+        std::size_t owner = unowned;
+        int depth = 0;
+        int ceiling = std::numeric_limits<int>::max();
+        std::set<std::pair<int, std::size_t>> waiters;
+    };
+
+    enum class State { Waiting, Ready, Blocked, Done };
+
+    LockProtocol protocol;
+    std::vector<LockRequest> requests;
+
+    std::vector<Resource> resources;
+    std::vector<std::vector<LockEvent>> events;
+    std::vector<std::size_t> nextEvent;
+    std::vector<std::multiset<int>> donations;
+    std::vector<int> effectivePriority;
+    std::vector<State> state;
+    std::vector<std::size_t> blockedOn;
+    std::vector<int> blockedSince;
+    std::vector<int> blocked;
+    std::set<std::pair<int, std::size_t>> ready;
+    std::size_t deadlocked = 0;
+
+    void buildLockTables() {
+        const ProcessTable& in = *input;
+        std::unordered_map<int, std::size_t> resourceIndex;
+        resources.clear();
+        events.assign(in.size(), {});
+        nextEvent.assign(in.size(), 0);
+
+        auto byId = [](const LockRequest& a, const LockRequest& b) { return a.processId < b.processId; };
+        std::vector<LockRequest> sorted = requests;
+        std::stable_sort(sorted.begin(), sorted.end(), byId);
+
+        for (std::size_t p = 0; p < in.size(); ++p) {
+            auto [first, last] = std::equal_range(sorted.begin(), sorted.end(), LockRequest{in[p].id, 0, 0, 0}, byId);
+            for (auto it = first; it != last; ++it) {
+                if (it->acquireOffset >= in[p].burstTime) continue;
+                auto [slot, added] = resourceIndex.try_emplace(it->resource, resources.size());
+                if (added) resources.emplace_back();
+                Resource& r = resources[slot->second];
+                r.ceiling = std::min(r.ceiling, in[p].priority);
+                events[p].push_back({it->acquireOffset, true, slot->second});
+                events[p].push_back({std::min(it->releaseOffset, in[p].burstTime), false, slot->second});
+            }
+            // Releases sort ahead of acquires at the same offset.
+            std::stable_sort(events[p].begin(), events[p].end(), [](const LockEvent& a, const LockEvent& b) {
+                return a.offset != b.offset ? a.offset < b.offset : !a.acquire && b.acquire;
+            });
+        }
+    }
+
+    // Recomputes p's effective priority and walks it down the chain of holders
+    // that p (transitively) waits on.
+    void updatePriority(std::size_t p) {
+        for (;;) {
+            int base = (*input)[p].priority;
+            int next = donations[p].empty() ? base : std::min(base, *donations[p].begin());
+            int old = effectivePriority[p];
+            if (next == old) return;
+            effectivePriority[p] = next;
+
+            if (state[p] == State::Ready) {
+                ready.erase({old, p});
+                ready.insert({next, p});
+                return;
+            }
+            if (state[p] != State::Blocked) return;
+
+            Resource& r = resources[blockedOn[p]];
+            r.waiters.erase({old, p});
+            r.waiters.insert({next, p});
+            if (protocol != LockProtocol::Inheritance) return;
+            donations[r.owner].erase(donations[r.owner].find(old));
+            donations[r.owner].insert(next);
+            p = r.owner;
+        }
+    }
+
+    void grant(std::size_t p, std::size_t res) {
+        Resource& r = resources[res];
+        r.owner = p;
+        r.depth = 1;
+        if (protocol == LockProtocol::Ceiling) {
+            donations[p].insert(r.ceiling);
+        }
+        if (protocol == LockProtocol::Inheritance) {
+            for (const auto& [prio, w] : r.waiters) donations[p].insert(prio);
+        }
+        updatePriority(p);
+    }
+
+    void release(std::size_t p, std::size_t res, int time) {
+        Resource& r = resources[res];
+        if (r.owner != p || --r.depth > 0) return;
+        if (protocol == LockProtocol::Ceiling) {
+            donations[p].erase(donations[p].find(r.ceiling));
+        }
+        if (protocol == LockProtocol::Inheritance) {
+            for (const auto& [prio, w] : r.waiters) donations[p].erase(donations[p].find(prio));
+        }
+        r.owner = unowned;
+        updatePriority(p);
+
+        if (r.waiters.empty()) return;
+        std::size_t w = r.waiters.begin()->second;
+        r.waiters.erase(r.waiters.begin());
+        blocked[w] += time - blockedSince[w];
+        state[w] = State::Ready;
+        ready.insert({effectivePriority[w], w});
+        ++nextEvent[w];
+        grant(w, res);
+    }
+
+    // Returns false when p has to wait for the resource.
+    bool acquire(std::size_t p, std::size_t res, int time) {
+        Resource& r = resources[res];
+        if (r.owner == unowned) {
+            grant(p, res);
+            return true;
+        }
+        if (r.owner == p) {
+            ++r.depth;
+            return true;
+        }
+        ready.erase({effectivePriority[p], p});
+        state[p] = State::Blocked;
+        blockedOn[p] = res;
+        blockedSince[p] = time;
+        r.waiters.insert({effectivePriority[p], p});
+        if (protocol == LockProtocol::Inheritance) {
+            donations[r.owner].insert(effectivePriority[p]);
+            updatePriority(r.owner);
+        }
+        return false;
+    }
+
+public:
+    explicit ResourceScheduler(LockProtocol protocol = LockProtocol::Inheritance) : protocol(protocol) {}
+
+    // Holds resource from acquireOffset to releaseOffset units into the burst of
+    // every process with this id; releases past the burst happen at completion.
+    bool addLockRequest(int processId, int resource, int acquireOffset, int releaseOffset) {
+        if (acquireOffset < 0 || releaseOffset <= acquireOffset) return false;
+        requests.push_back({processId, resource, acquireOffset, releaseOffset});
+        return true;
+    }
+
+    void clearLockRequests() { requests.clear(); }
+
+    // Time each process spent waiting for a lock, plus the time it was ready
+    // but kept off the CPU by a holder running at a lent or ceiling priority.
+    std::span<const int> blockingTimes() const { return blocked; }
+    std::size_t deadlockedCount() const { return deadlocked; }
+
+    void schedule() override {
+        beginRun(true);
+        const ProcessTable& in = *input;
+        buildLockTables();
+
+        donations.assign(in.size(), {});
+        effectivePriority.resize(in.size());
+        for (std::size_t p = 0; p < in.size(); ++p) effectivePriority[p] = in[p].priority;
+        state.assign(in.size(), State::Waiting);
+        blockedOn.assign(in.size(), 0);
+        blockedSince.assign(in.size(), 0);
+        blocked.assign(in.size(), 0);
+        ready.clear();
+        deadlocked = 0;
+
+        int currentTime = 0;
+        size_t completed = 0;
+        size_t i = 0;
+
+        while (completed < in.size() && !stopRequested) {
+            for (; i < in.size() && in[i].arrivalTime <= currentTime; ++i) {
+                state[i] = State::Ready;
+                ready.insert({effectivePriority[i], i});
+            }
+
+            if (ready.empty()) {
+                if (i == in.size()) {
+                    // Everything left is waiting on a lock cycle.
+                    deadlocked = in.size() - completed;
+                    for (std::size_t p = 0; p < in.size(); ++p) {
+                        if (state[p] == State::Blocked) blocked[p] += currentTime - blockedSince[p];
+                    }
+                    break;
+                }
+                recordIdle(currentTime, in[i].arrivalTime);
+                currentTime = in[i].arrivalTime;
+                continue;
+            }
+
+            size_t p = ready.begin()->second;
+            if (responseTime[p] == -1) {
+                responseTime[p] = currentTime - in[p].arrivalTime;
+            }
+
+            int executed = in[p].burstTime - remainingTime[p];
+            bool handled = false;
+            while (nextEvent[p] < events[p].size() && events[p][nextEvent[p]].offset == executed) {
+                const LockEvent& e = events[p][nextEvent[p]];
+                handled = true;
+                if (e.acquire) {
+                    if (!acquire(p, e.resource, currentTime)) break;
+                } else {
+                    release(p, e.resource, currentTime);
+                }
+                ++nextEvent[p];
+            }
+            if (handled && (ready.empty() || ready.begin()->second != p)) continue;
+
+            int executionTime = remainingTime[p];
+            if (nextEvent[p] < events[p].size()) {
+                executionTime = std::min(executionTime, events[p][nextEvent[p]].offset - executed);
+            }
+            if (i < in.size()) {
+                executionTime = std::min(executionTime, in[i].arrivalTime - currentTime);
+            }
+
+            // A boosted holder keeps every ready process that would otherwise
+            // preempt it off the CPU; that time counts as blocking too.
+            if (effectivePriority[p] < in[p].priority) {
+                for (auto it = ready.begin(); it != ready.end() && it->first < in[p].priority; ++it) {
+                    if (it->second != p) blocked[it->second] += executionTime;
+                }
+            }
+
+            remainingTime[p] -= executionTime;
+            recordRun(p, currentTime, currentTime + executionTime);
+            currentTime += executionTime;
+
+            if (remainingTime[p] == 0) {
+                // Locks still held at the end of the burst go with it.
+                for (; nextEvent[p] < events[p].size(); ++nextEvent[p]) {
+                    release(p, events[p][nextEvent[p]].resource, currentTime);
+                }
+                ready.erase({effectivePriority[p], p});
+                state[p] = State::Done;
+                complete(p, currentTime);
+                completed++;
+            }
+        }
+        endRun();
+    }
+
+    void printResults() override {
+        static constexpr std::string_view names[] = {"no protocol", "priority inheritance", "priority ceiling"};
+        std::cout << "Resource-Aware Preemptive Priority Scheduling Results (" << names[static_cast<int>(protocol)] << "):\n";
+        Scheduler::printResults();
+        std::cout << "Process\tBlocked" << std::endl;
+        for (std::size_t k = 0; k < blocked.size(); ++k) {
+            std::cout << (*input)[k].id << "\t" << blocked[k] << std::endl;
+        }
+        if (deadlocked > 0) {
+            std::cout << "Deadlocked processes: " << deadlocked << std::endl;
+        }
+    }
+};
+
+// Non-preemptive list scheduling of a precedence DAG on identical CPUs. A process
+// is ready once it has arrived and all its predecessors have completed.
+// Both policies rank processes by upward rank, the longest burst path from the
+// process to an exit of the DAG:
+// - CriticalPath dispatches the ready process with the highest rank whenever a
+//   CPU frees up.
+// - Heft places processes in decreasing rank order, each on the CPU where it
+//   finishes earliest. This is HEFT without insertion, for identical CPUs with
+//   no communication cost.
+// Dependencies are kept as CSR adjacency, so a run costs O((n + m) log n).
+enum class DagPolicy { CriticalPath, Heft };
+
+class DagScheduler : public Scheduler {
+private:
+    std::size_t cpuCount;
+    DagPolicy policy;
+    std::vector<std::pair<int, int>> dependencies;  // (predecessor id, successor id)
+
+    std::vector<std::size_t> successorOffsets;
+    std::vector<std::uint32_t> successors;
+    std::vector<std::uint32_t> pendingPredecessors;
+    std::vector<std::uint32_t> topologicalOrder;
+    std::vector<int> rank;
+    int makespanTime = 0;
+    int criticalPath = 0;
+    int workLowerBound = 0;
+    std::size_t unschedulable = 0;
+
+    // Builds the CSR successor lists and upward ranks; processes on a cycle
+    // keep their predecessors pending and never become ready.
+    void buildGraph() {
+        const ProcessTable& in = *input;
+        std::unordered_map<int, std::uint32_t> row;
+        row.reserve(in.size());
+        for (std::size_t p = 0; p < in.size(); ++p) row.try_emplace(in[p].id, static_cast<std::uint32_t>(p));
+
+        successorOffsets.assign(in.size() + 1, 0);
+        pendingPredecessors.assign(in.size(), 0);
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+        edges.reserve(dependencies.size());
+        for (const auto& [pred, succ] : dependencies) {
+            auto from = row.find(pred);
+            auto to = row.find(succ);
+            if (from == row.end() || to == row.end()) continue;
+            edges.emplace_back(from->second, to->second);
+            successorOffsets[from->second + 1]++;
+            pendingPredecessors[to->second]++;
+        }
+        std::partial_sum(successorOffsets.begin(), successorOffsets.end(), successorOffsets.begin());
+        successors.resize(edges.size());
+        std::vector<std::size_t> fill(successorOffsets.begin(), successorOffsets.end() - 1);
+        for (const auto& [from, to] : edges) successors[fill[from]++] = to;
+
+        // Kahn's algorithm gives a topological order to accumulate ranks over.
+        std::vector<std::uint32_t>& order = topologicalOrder;
+        order.clear();
+        order.reserve(in.size());
+        std::vector<std::uint32_t> indegree = pendingPredecessors;
+        for (std::size_t p = 0; p < in.size(); ++p) {
+            if (indegree[p] == 0) order.push_back(static_cast<std::uint32_t>(p));
+        }
+        for (std::size_t k = 0; k < order.size(); ++k) {
+            for (std::size_t e = successorOffsets[order[k]]; e < successorOffsets[order[k] + 1]; ++e) {
+                if (--indegree[successors[e]] == 0) order.push_back(successors[e]);
+            }
+        }
+        unschedulable = in.size() - order.size();
+
+        rank.assign(in.size(), 0);
+        criticalPath = 0;
+        for (std::size_t k = order.size(); k-- > 0;) {
+            std::uint32_t p = order[k];
+            int longest = 0;
+            for (std::size_t e = successorOffsets[p]; e < successorOffsets[p + 1]; ++e) {
+                longest = std::max(longest, rank[successors[e]]);
+            }
+            rank[p] = in[p].burstTime + longest;
+            criticalPath = std::max(criticalPath, in[p].arrivalTime + rank[p]);
+        }
+
+        long long work = 0;
+        for (std::uint32_t p : order) work += in[p].burstTime;
+        int firstArrival = in.empty() ? 0 : in.front().arrivalTime;
+        workLowerBound = firstArrival + static_cast<int>((work + cpuCount - 1) / cpuCount);
+    }
+
+    void scheduleCriticalPath() {
+        const ProcessTable& in = *input;
+        auto byRank = [this](std::size_t a, std::size_t b) { return rank[a] != rank[b] ? rank[a] < rank[b] : a > b; };
+        ReadyHeap ready(readyStorage, byRank);
+
+        using Running = std::pair<int, std::size_t>;  // (completion time, process)
+        std::priority_queue<Running, std::vector<Running>, std::greater<>> running;
+        std::vector<std::size_t> cpuOf(in.size());
+        std::vector<std::size_t> freeCpus(cpuCount);
+        std::iota(freeCpus.rbegin(), freeCpus.rend(), std::size_t{0});
+        std::vector<int> freeSince(cpuCount, 0);
+        std::vector<bool> arrived(in.size(), false);
+
+        auto release = [&](std::size_t p) {
+            for (std::size_t e = successorOffsets[p]; e < successorOffsets[p + 1]; ++e) {
+                std::uint32_t s = successors[e];
+                if (--pendingPredecessors[s] == 0 && arrived[s]) ready.push(s);
+            }
+        };
+
+        int currentTime = 0;
+        std::size_t i = 0;
+        while (!stopRequested) {
+            for (; i < in.size() && in[i].arrivalTime <= currentTime; ++i) {
+                arrived[i] = true;
+                if (pendingPredecessors[i] == 0) ready.push(i);
+            }
+
+            while (!freeCpus.empty() && !ready.empty()) {
+                std::size_t p = ready.top();
+                ready.pop();
+                std::size_t cpu = freeCpus.back();
+                freeCpus.pop_back();
+                recordIdle(freeSince[cpu], currentTime, cpu);
+                responseTime[p] = currentTime - in[p].arrivalTime;
+                recordRun(p, currentTime, currentTime + in[p].burstTime, cpu);
+                cpuOf[p] = cpu;
+                running.push({currentTime + in[p].burstTime, p});
+            }
+
+            if (running.empty() && i == in.size()) break;
+            currentTime = running.empty() ? in[i].arrivalTime
+                        : i < in.size() ? std::min(running.top().first, in[i].arrivalTime)
+                        : running.top().first;
+
+            while (!running.empty() && running.top().first == currentTime) {
+                std::size_t p = running.top().second;
+                running.pop();
+                complete(p, currentTime);
+                freeCpus.push_back(cpuOf[p]);
+                freeSince[cpuOf[p]] = currentTime;
+                release(p);
+            }
+            // Freed CPUs are taken lowest index first.
+            std::sort(freeCpus.begin(), freeCpus.end(), std::greater<>());
+        }
+        makespanTime = currentTime;
+        for (std::size_t cpu = 0; cpu < cpuCount; ++cpu) recordIdle(freeSince[cpu], makespanTime, cpu);
+    }
+
+    void scheduleHeft() {
+        const ProcessTable& in = *input;
+        ReadyStorage& order = readyStorage;
+        order.assign(topologicalOrder.begin(), topologicalOrder.end());
+        // Ranks never grow along an edge, so a stable sort of a topological
+        // order is still topological where zero-length bursts tie.
+        std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) { return rank[a] > rank[b]; });
+
+        std::vector<int> readyTime(in.size());
+        for (std::size_t p = 0; p < in.size(); ++p) readyTime[p] = in[p].arrivalTime;
+        using Cpu = std::pair<int, std::size_t>;  // (available from, cpu)
+        std::priority_queue<Cpu, std::vector<Cpu>, std::greater<>> cpus;
+        for (std::size_t cpu = 0; cpu < cpuCount; ++cpu) cpus.push({0, cpu});
+
+        for (std::size_t p : order) {
+            auto [available, cpu] = cpus.top();
+            cpus.pop();
+            int start = std::max(available, readyTime[p]);
+            int finish = start + in[p].burstTime;
+            recordIdle(available, start, cpu);
+            recordRun(p, start, finish, cpu);
+            responseTime[p] = start - in[p].arrivalTime;
+            completionTime[p] = finish;
+            cpus.push({finish, cpu});
+            for (std::size_t e = successorOffsets[p]; e < successorOffsets[p + 1]; ++e) {
+                std::uint32_t s = successors[e];
+                readyTime[s] = std::max(readyTime[s], finish);
+            }
+        }
+
+        // Completions are reported in time order, as the other policies do.
+        std::ranges::sort(order, {}, [this](std::size_t p) { return completionTime[p]; });
+        makespanTime = 0;
+        for (std::size_t p : order) {
+            int finish = std::exchange(completionTime[p], -1);
+            complete(p, finish);
+            makespanTime = finish;
+        }
+        while (!cpus.empty()) {
+            auto [available, cpu] = cpus.top();
+            cpus.pop();
+            recordIdle(available, makespanTime, cpu);
+        }
+    }
+
+public:
+    explicit DagScheduler(std::size_t cpus = 2, DagPolicy policy = DagPolicy::CriticalPath)
+        : cpuCount(std::max<std::size_t>(cpus, 1)), policy(policy) {}
+
+    // Successor may not start before predecessor completes. Ids that match no
+    // process when schedule() runs are ignored.
+    bool addDependency(int predecessorId, int successorId) {
+        if (predecessorId == successorId) return false;
+        dependencies.emplace_back(predecessorId, successorId);
+        return true;
+    }
+
+    void reserveDependencies(std::size_t edges) { dependencies.reserve(edges); }
+    void clearDependencies() { dependencies.clear(); }
+
+    int makespan() const { return makespanTime; }
+
+    // Longest arrival-plus-chain of bursts; no schedule can finish earlier.
+    int criticalPathBound() const { return criticalPath; }
+
+    // Total work of the schedulable processes spread evenly over all CPUs from
+    // the first arrival.
+    int workBound() const { return workLowerBound; }
+
+    // Processes on a dependency cycle, which are never run.
+    std::size_t unschedulableCount() const { return unschedulable; }
+
+    void schedule() override {
+        beginRun(false, cpuCount);
+        buildGraph();
+        if (policy == DagPolicy::Heft) {
+            scheduleHeft();
+        } else {
+            scheduleCriticalPath();
+        }
+        endRun();
+    }
+
+    void printResults() override {
+        std::cout << (policy == DagPolicy::Heft ? "HEFT" : "Critical-Path-First") << " DAG Scheduling Results ("
+                  << cpuCount << " CPUs):\n";
+        Scheduler::printResults();
+        int bound = std::max(criticalPath, workLowerBound);
+        std::cout << "Makespan: " << makespanTime << " (lower bound " << bound << ", critical path " << criticalPath
+                  << ", work " << workLowerBound << ", ratio " << (bound > 0 ? static_cast<double>(makespanTime) / bound : 1.0)
+                  << ")" << std::endl;
+        if (unschedulable > 0) {
+            std::cout << "Processes on a dependency cycle (not in the averages): " << unschedulable << std::endl;
+        }
+    }
+};
+
+// A running FCFS, SJF or Priority queue that processes are submitted to over
+// time, for admission decisions. The ready queue is a treap ordered by policy
+// rank, then submission order. Each node keeps its subtree's size and burst
+// sum, so submit, dispatch and predictCompletion are all O(log n) expected.
+enum class QueuePolicy { Fcfs, Sjf, Priority };
+
+class LiveScheduler {
+public:
+    using Sink = std::function<void(const Process&)>;
+
+private:
+    static constexpr std::uint32_t nil = 0;
+
+    struct Node {
+        long long rank;
+        std::uint64_t sequence;
+        std::uint32_t heapKey;
+        std::uint32_t left = nil;
+        std::uint32_t right = nil;
+        std::uint32_t size = 1;
+        long long burstSum;
+        ProcessInput process;
+    };
+
+    QueuePolicy policy;
+    Sink sink;
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> freeNodes;
+    std::uint32_t root = nil;
+    std::uint64_t nextSequence = 0;
+    std::uint32_t random = 2463534242u;
+    int now = 0;
+    int cpuFreeAt = 0;  // Never before now.
+
+    long long rankOf(const ProcessInput& p) const {
+        switch (policy) {
+        case QueuePolicy::Sjf: return p.burstTime;
+        case QueuePolicy::Priority: return -static_cast<long long>(p.priority);
+        case QueuePolicy::Fcfs: break;
+        }
+        return 0;
+    }
+
+    bool before(const Node& a, long long rank, std::uint64_t sequence) const {
+        return a.rank != rank ? a.rank < rank : a.sequence < sequence;
+    }
+
+    void update(std::uint32_t t) {
+        Node& n = nodes[t];
+        n.size = 1 + nodes[n.left].size + nodes[n.right].size;
+        n.burstSum = n.process.burstTime + nodes[n.left].burstSum + nodes[n.right].burstSum;
+    }
+
+    std::uint32_t merge(std::uint32_t a, std::uint32_t b) {
+        if (a == nil) return b;
+        if (b == nil) return a;
+        if (nodes[a].heapKey > nodes[b].heapKey) {
+            nodes[a].right = merge(nodes[a].right, b);
+            update(a);
+            return a;
+        }
+        nodes[b].left = merge(a, nodes[b].left);
+        update(b);
+        return b;
+    }
+
+    // Splits t into the nodes ranked before (rank, sequence) and the rest.
+    std::pair<std::uint32_t, std::uint32_t> split(std::uint32_t t, long long rank, std::uint64_t sequence) {
+        if (t == nil) return {nil, nil};
+        if (before(nodes[t], rank, sequence)) {
+            auto [l, r] = split(nodes[t].right, rank, sequence);
+            nodes[t].right = l;
+            update(t);
+            return {t, r};
+        }
+        auto [l, r] = split(nodes[t].left, rank, sequence);
+        nodes[t].left = r;
+        update(t);
+        return {l, t};
+    }
+
+    std::uint32_t popFirst(std::uint32_t t, std::uint32_t& first) {
+        if (nodes[t].left == nil) {
+            first = t;
+            return nodes[t].right;
+        }
+        nodes[t].left = popFirst(nodes[t].left, first);
+        update(t);
+        return t;
+    }
+
+    // Burst total of the queued processes that would run before (rank, sequence).
+    long long workBefore(long long rank, std::uint64_t sequence) const {
+        long long work = 0;
+        for (std::uint32_t t = root; t != nil;) {
+            const Node& n = nodes[t];
+            if (before(n, rank, sequence)) {
+                work += nodes[n.left].burstSum + n.process.burstTime;
+                t = n.right;
+            } else {
+                t = n.left;
+            }
+        }
+        return work;
+    }
+
+    // Burst total of the queue prefix that starts before the CPU has done
+    // `work` more units; those are the processes dispatched by then.
+    long long startedWork(long long work) const {
+        long long done = 0;
+        for (std::uint32_t t = root; t != nil;) {
+            const Node& n = nodes[t];
+            if (done + nodes[n.left].burstSum < work) {
+                done += nodes[n.left].burstSum + n.process.burstTime;
+                t = n.right;
+            } else {
+                t = n.left;
+            }
+        }
+        return done;
+    }
+
+    void dispatchFirst() {
+        std::uint32_t first = nil;
+        root = popFirst(root, first);
+        const ProcessInput& in = nodes[first].process;
+        int start = cpuFreeAt;
+        cpuFreeAt += in.burstTime;
+        if (sink) {
+            Process p(in.id, in.arrivalTime, in.burstTime, in.priority);
+            p.remainingTime = 0;
+            p.responseTime = start - in.arrivalTime;
+            p.completionTime = cpuFreeAt;
+            p.turnaroundTime = p.completionTime - p.arrivalTime;
+            p.waitingTime = p.turnaroundTime - p.burstTime;
+            sink(p);
+        }
+        freeNodes.push_back(first);
+    }
+
+public:
+    // The sink receives each process, with its results, when it is dispatched.
+    explicit LiveScheduler(QueuePolicy policy, Sink sink = nullptr) : policy(policy), sink(std::move(sink)) {
+        nodes.push_back(Node{0, 0, 0, nil, nil, 0, 0, {}});
+    }
+
+    int currentTime() const { return now; }
+    std::size_t queued() const { return nodes[root].size; }
+
+    // Runs the schedule up to time: everything that starts before it is dispatched.
+    void advance(int time) {
+        if (time <= now) return;
+        while (root != nil && cpuFreeAt < time) {
+            dispatchFirst();
+        }
+        now = time;
+        cpuFreeAt = std::max(cpuFreeAt, now);
+    }
+
+    // Queues p at its arrival time, or now if that has passed; returns the
+    // completion time predicted at submission.
+    int submit(const Process& p) {
+        advance(p.arrivalTime);
+        int completion = predictCompletion(p);
+        std::uint32_t t;
+        if (freeNodes.empty()) {
+            t = static_cast<std::uint32_t>(nodes.size());
+            nodes.emplace_back();
+        } else {
+            t = freeNodes.back();
+            freeNodes.pop_back();
+        }
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        ProcessInput in{p.id, std::max(p.arrivalTime, now), p.burstTime, p.priority};
+        nodes[t] = Node{rankOf(in), nextSequence++, random, nil, nil, 1, in.burstTime, in};
+        auto [l, r] = split(root, nodes[t].rank, nodes[t].sequence);
+        root = merge(merge(l, t), r);
+        return completion;
+    }
+
+    // When p would complete if it were submitted and nothing else arrived after
+    // it. Exact for FCFS; under SJF and Priority later arrivals can still go
+    // ahead of it.
+    int predictCompletion(const Process& p) const {
+        ProcessInput in{p.id, std::max(p.arrivalTime, now), p.burstTime, p.priority};
+        long long ahead = workBefore(rankOf(in), nextSequence);
+        long long started = startedWork(in.arrivalTime - cpuFreeAt);
+        long long freeAt = std::max<long long>(in.arrivalTime, cpuFreeAt + started);
+        return static_cast<int>(freeAt + std::max(ahead - started, 0LL) + in.burstTime);
+    }
+
+    // Dispatches everything queued; returns when the CPU goes idle.
+    int drain() {
+        while (root != nil) {
+            dispatchFirst();
+        }
+        return cpuFreeAt;
+    }
+};
+
+// Builds a scheduler from a policy spec such as "sjf", "rr:4" or "psjf:0.5"
+// (predictive SJF with alpha 0.5); nullptr if unknown.
+inline std::unique_ptr<Scheduler> makeScheduler(std::string_view spec) {
+    if (spec == "fcfs") return std::make_unique<FCFSScheduler>();
+    if (spec == "sjf") return std::make_unique<SJFScheduler>();
+    if (spec == "srtf") return std::make_unique<SRTFScheduler>();
+    if (spec == "priority") return std::make_unique<PriorityScheduler>();
+    if (spec == "preemptive-priority") return std::make_unique<PreemptivePriorityScheduler>();
+    if (spec.starts_with("psjf") || spec.starts_with("psrtf")) {
+        double alpha = 0.5;
+        auto colon = spec.find(':');
+        if (colon != std::string_view::npos) {
+            auto digits = spec.substr(colon + 1);
+            auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), alpha);
+            if (ec != std::errc() || end != digits.data() + digits.size() || alpha < 0 || alpha > 1) {
+                return nullptr;
+            }
+        }
+        auto name = spec.substr(0, colon);
+        if (name == "psjf") return std::make_unique<PredictiveSJFScheduler>(BurstPredictor(alpha));
+        if (name == "psrtf") return std::make_unique<PredictiveSRTFScheduler>(BurstPredictor(alpha));
+        return nullptr;
+    }
+    if (spec.starts_with("rr:")) {
+        int quantum = 0;
+        auto digits = spec.substr(3);
+        auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), quantum);
+        if (ec == std::errc() && end == digits.data() + digits.size() && quantum > 0) {
+            return std::make_unique<RoundRobinScheduler>(quantum);
+        }
+    }
+    return nullptr;
+}
+
+// Integers stored in `width` bits each as offsets from a base. Writing a value
+// outside the current range re-packs the column with room for it, at least one
+// bit wider, so a column settles at the width its data needs after a few
+// re-packs. A column of equal values takes no storage at all.
+class PackedColumn {
+private:
+    std::vector<std::uint64_t> words;
+    std::size_t count = 0;
+    long long base = 0;
+    unsigned width = 0;
+
+    static std::size_t wordsFor(std::size_t n, unsigned bits) {
+        // One spare word lets a read straddle the end without a bounds check.
+        return bits == 0 ? 0 : (n * bits + 63) / 64 + 1;
+    }
+
+    std::uint64_t offsetAt(std::size_t k) const {
+        if (width == 0) return 0;
+        std::size_t bit = k * width;
+        unsigned shift = bit & 63;
+        std::uint64_t v = words[bit >> 6] >> shift;
+        if (shift + width > 64) v |= words[(bit >> 6) + 1] << (64 - shift);
+        return v & ((std::uint64_t{1} << width) - 1);
+    }
+
+    void storeOffset(std::size_t k, std::uint64_t v) {
+        if (width == 0) return;
+        std::size_t bit = k * width;
+        unsigned shift = bit & 63;
+        std::uint64_t mask = (std::uint64_t{1} << width) - 1;
+        std::uint64_t& low = words[bit >> 6];
+        low = (low & ~(mask << shift)) | (v << shift);
+        if (shift + width > 64) {
+            std::uint64_t& high = words[(bit >> 6) + 1];
+            high = (high & ~(mask >> (64 - shift))) | (v >> (64 - shift));
+        }
+    }
+
+    void refit(long long value) {
+        long long high = std::max(base + static_cast<long long>((std::uint64_t{1} << width) - 1), value);
+        long long low = std::min(base, value);
+        unsigned bits = std::max(width + 1, static_cast<unsigned>(std::bit_width(static_cast<std::uint64_t>(high - low))));
+        // Headroom goes below the base when values are falling.
+        long long newBase = value < base ? high - static_cast<long long>((std::uint64_t{1} << bits) - 1) : low;
+
+        PackedColumn wider;
+        wider.words.assign(wordsFor(count, bits), 0);
+        wider.count = count;
+        wider.base = newBase;
+        wider.width = bits;
+        for (std::size_t k = 0; k < count; ++k) {
+            wider.storeOffset(k, static_cast<std::uint64_t>((*this)[k] - newBase));
+        }
+        *this = std::move(wider);
+    }
+
+public:
+    explicit PackedColumn(std::size_t n = 0, long long value = 0) : count(n), base(value) {}
+
+    std::size_t size() const { return count; }
+    unsigned bits() const { return width; }
+    std::size_t bytes() const { return words.capacity() * sizeof(std::uint64_t); }
+
+    long long operator[](std::size_t k) const { return base + static_cast<long long>(offsetAt(k)); }
+
+    void set(std::size_t k, long long value) {
+        if (value < base || static_cast<std::uint64_t>(value - base) >> width != 0) refit(value);
+        storeOffset(k, static_cast<std::uint64_t>(value - base));
+    }
+
+    void push_back(long long value) {
+        if (count == 0) base = value;
+        ++count;
+        if (words.size() < wordsFor(count, width)) {
+            words.resize(std::max(wordsFor(count, width), words.size() * 2), 0);
+        }
+        set(count - 1, value);
+    }
+
+    void shrink_to_fit() {
+        words.resize(wordsFor(count, width));
+        words.shrink_to_fit();
+    }
+};
+
+// Process input kept as bit-packed columns, for runs too large for a
+// ProcessTable. Ids are stored as their difference from the row number, so
+// sequential ids take no space. Rows must be appended in arrival order.
+class CompactProcessTable {
+private:
+    PackedColumn idOffsets;
+    PackedColumn arrivals;
+    PackedColumn bursts;
+    PackedColumn priorities;
+
+public:
+    CompactProcessTable() = default;
+
+    // Sorts the rows by arrival, packs them and releases the caller's buffer.
+    explicit CompactProcessTable(ProcessTable&& rows) {
+        sortByArrival(rows);
+        for (const auto& p : rows) append(p);
+        ProcessTable().swap(rows);
+        shrink_to_fit();
+    }
+
+    // Returns false, and leaves the table as it was, for a row that arrives
+    // before the last one.
+    bool append(const ProcessInput& p) {
+        std::size_t k = size();
+        if (k > 0 && p.arrivalTime < arrivals[k - 1]) return false;
+        idOffsets.push_back(static_cast<long long>(p.id) - static_cast<long long>(k));
+        arrivals.push_back(p.arrivalTime);
+        bursts.push_back(p.burstTime);
+        priorities.push_back(p.priority);
+        return true;
+    }
+
+    void shrink_to_fit() {
+        idOffsets.shrink_to_fit();
+        arrivals.shrink_to_fit();
+        bursts.shrink_to_fit();
+        priorities.shrink_to_fit();
+    }
+
+    std::size_t size() const { return arrivals.size(); }
+
+    int id(std::size_t k) const { return static_cast<int>(idOffsets[k] + static_cast<long long>(k)); }
+    int arrivalTime(std::size_t k) const { return static_cast<int>(arrivals[k]); }
+    int burstTime(std::size_t k) const { return static_cast<int>(bursts[k]); }
+    int priority(std::size_t k) const { return static_cast<int>(priorities[k]); }
+    const PackedColumn& burstColumn() const { return bursts; }
+
+    ProcessInput operator[](std::size_t k) const { return {id(k), arrivalTime(k), burstTime(k), priority(k)}; }
+
+    unsigned bitsPerRow() const { return idOffsets.bits() + arrivals.bits() + bursts.bits() + priorities.bits(); }
+    std::size_t bytes() const { return idOffsets.bytes() + arrivals.bytes() + bursts.bytes() + priorities.bytes(); }
+};
+
+// Runs FCFS, SJF, SRTF, Priority or Preemptive Priority over a
+// CompactProcessTable. The only result it stores is the packed waiting time of
+// each process. Completion and turnaround follow from waiting, arrival and
+// burst. Response equals waiting for the non-preemptive policies, and the
+// preemptive ones keep one more packed column for it. Ties and preemption
+// points are the same as in the Scheduler classes, so results match them.
+class CompactScheduler {
+public:
+    enum class Policy { Fcfs, Sjf, Srtf, Priority, PreemptivePriority };
+
+private:
+    Policy policy;
+    std::shared_ptr<const CompactProcessTable> input;
+    PackedColumn waiting;
+    PackedColumn response;
+    PackedColumn remaining;
+    ReadyStorage readyStorage;
+    ScheduleMetrics summary{};
+
+    bool preemptive() const { return policy == Policy::Srtf || policy == Policy::PreemptivePriority; }
+
+    template <typename Compare>
+    void run(Compare cmp) {
+        const CompactProcessTable& in = *input;
+        const std::size_t n = in.size();
+        waiting = PackedColumn(n);
+        response = PackedColumn(preemptive() ? n : 0);
+        if (preemptive()) remaining = in.burstColumn();
+        ReadyHeap pq(readyStorage, cmp);
+
+        int currentTime = 0;
+        std::size_t completed = 0;
+        std::size_t i = 0;
+        while (completed < n) {
+            for (; i < n && in.arrivalTime(i) <= currentTime; ++i) {
+                pq.push(i);
+            }
+
+            if (pq.empty()) {
+                currentTime = in.arrivalTime(i);
+                continue;
+            }
+
+            std::size_t p = pq.top();
+            pq.pop();
+
+            if (!preemptive()) {
+                waiting.set(p, currentTime - in.arrivalTime(p));
+                currentTime += in.burstTime(p);
+                completed++;
+                continue;
+            }
+
+            int left = static_cast<int>(remaining[p]);
+            if (left == in.burstTime(p)) {
+                response.set(p, currentTime - in.arrivalTime(p));
+            }
+            int executionTime = i < n ? std::min(left, in.arrivalTime(i) - currentTime) : left;
+            currentTime += executionTime;
+            remaining.set(p, left - executionTime);
+
+            if (left == executionTime) {
+                waiting.set(p, currentTime - in.arrivalTime(p) - in.burstTime(p));
+                completed++;
+            } else {
+                pq.push(p);
+            }
+        }
+        remaining = PackedColumn();
+    }
+
+public:
+    explicit CompactScheduler(Policy policy) : policy(policy) {}
+
+    void setInput(std::shared_ptr<const CompactProcessTable> table) {
+        input = std::move(table);
+        waiting = PackedColumn();
+        response = PackedColumn();
+    }
+
+    std::size_t size() const { return input ? input->size() : 0; }
+
+    void schedule() {
+        const CompactProcessTable& in = *input;
+        switch (policy) {
+        case Policy::Fcfs:
+            run([](std::size_t a, std::size_t b) { return a > b; });
+            break;
+        case Policy::Sjf:
+            run([&in](std::size_t a, std::size_t b) {
+                int x = in.burstTime(a), y = in.burstTime(b);
+                return x != y ? x > y : a > b;
+            });
+            break;
+        case Policy::Srtf:
+            run([this](std::size_t a, std::size_t b) {
+                auto x = remaining[a], y = remaining[b];
+                return x != y ? x > y : a > b;
+            });
+            break;
+        case Policy::Priority:
+            run([&in](std::size_t a, std::size_t b) {
+                int x = in.priority(a), y = in.priority(b);
+                return x != y ? x < y : a > b;
+            });
+            break;
+        case Policy::PreemptivePriority:
+            run([&in](std::size_t a, std::size_t b) {
+                int x = in.priority(a), y = in.priority(b);
+                return x != y ? x > y : a > b;
+            });
+            break;
+        }
+        calculateMetrics();
+    }
+
+    Process result(std::size_t k) const {
+        const CompactProcessTable& in = *input;
+        Process p(in.id(k), in.arrivalTime(k), in.burstTime(k), in.priority(k));
+        if (k < waiting.size()) {
+            p.remainingTime = 0;
+            p.waitingTime = static_cast<int>(waiting[k]);
+            p.turnaroundTime = p.waitingTime + p.burstTime;
+            p.completionTime = p.arrivalTime + p.turnaroundTime;
+            p.responseTime = preemptive() ? static_cast<int>(response[k]) : p.waitingTime;
+        }
+        return p;
+    }
+
+    auto results() const {
+        return std::views::iota(std::size_t{0}, size()) |
+               std::views::transform([this](std::size_t k) { return result(k); });
+    }
+
+    ScheduleMetrics metrics() const { return summary; }
+
+    // Storage of the input and result columns, in bytes.
+    std::size_t bytes() const { return (input ? input->bytes() : 0) + waiting.bytes() + response.bytes(); }
+
+    // Same accumulation as the Scheduler classes, so the metrics agree with
+    // theirs for any input.
+    void calculateMetrics() { summary = computeMetrics(results()); }
+
+    void printResults() const {
+        printSchedule(results(), summary);
+    }
+};
+
+// Builds a compact scheduler from the policy names makeScheduler accepts;
+// nullptr for the others.
+inline std::unique_ptr<CompactScheduler> makeCompactScheduler(std::string_view spec) {
+    using Policy = CompactScheduler::Policy;
+    if (spec == "fcfs") return std::make_unique<CompactScheduler>(Policy::Fcfs);
+    if (spec == "sjf") return std::make_unique<CompactScheduler>(Policy::Sjf);
+    if (spec == "srtf") return std::make_unique<CompactScheduler>(Policy::Srtf);
+    if (spec == "priority") return std::make_unique<CompactScheduler>(Policy::Priority);
+    if (spec == "preemptive-priority") return std::make_unique<CompactScheduler>(Policy::PreemptivePriority);
+    return nullptr;
+}
+
+// Allocation-free engines shared by the compile-time schedules and the
+// fixed-capacity schedulers below. They follow the same steps as the Scheduler
+// classes above, using std::push_heap/std::pop_heap over caller storage in
+// place of std::priority_queue. Ready-queue storage must hold n pointers.
+constexpr auto byArrival = [](const Process& a, const Process& b) { return a.arrivalTime < b.arrivalTime; };
+
+// Merges two sorted neighbouring runs with rotations instead of a buffer,
+// keeping equal elements in order.
+constexpr void mergeWithoutBuffer(Process* first, Process* middle, Process* last) {
+    if (first == middle || middle == last) return;
+    if (last - first == 2) {
+        if (byArrival(*middle, *first)) std::iter_swap(first, middle);
+        return;
+    }
+    Process* firstCut;
+    Process* secondCut;
+    if (middle - first > last - middle) {
+        firstCut = first + (middle - first) / 2;
+        secondCut = std::lower_bound(middle, last, *firstCut, byArrival);
+    } else {
+        secondCut = middle + (last - middle) / 2;
+        firstCut = std::upper_bound(first, middle, *secondCut, byArrival);
+    }
+    Process* newMiddle = std::rotate(firstCut, middle, secondCut);
+    mergeWithoutBuffer(first, firstCut, newMiddle);
+    mergeWithoutBuffer(newMiddle, secondCut, last);
+}
+
+// Stable, so equal arrivals keep insertion order as in the ProcessTable
+// sortByArrival; std::stable_sort is neither constexpr nor allocation-free.
+constexpr void sortByArrival(Process* processes, std::size_t n) {
+    if (std::is_sorted(processes, processes + n, byArrival)) return;
+    constexpr std::size_t run = 16;
+    for (std::size_t from = 0; from < n; from += run) {
+        Process* last = processes + std::min(n, from + run);
+        for (Process* p = processes + from + 1; p < last; ++p) {
+            std::rotate(std::upper_bound(processes + from, p, *p, byArrival), p, p + 1);
+        }
+    }
+    for (std::size_t width = run; width < n; width *= 2) {
+        for (std::size_t from = 0; from + width < n; from += 2 * width) {
+            mergeWithoutBuffer(processes + from, processes + from + width, processes + std::min(n, from + 2 * width));
+        }
+    }
+}
+
+constexpr void fcfsEngine(Process* processes, std::size_t n) {
+    sortByArrival(processes, n);
+
+    int currentTime = 0;
+    for (std::size_t k = 0; k < n; ++k) {
+        Process& p = processes[k];
+        if (currentTime < p.arrivalTime) {
+            currentTime = p.arrivalTime;
+        }
+        p.responseTime = currentTime - p.arrivalTime;
+        p.completionTime = currentTime + p.burstTime;
+        p.turnaroundTime = p.completionTime - p.arrivalTime;
+        p.waitingTime = p.turnaroundTime - p.burstTime;
+        currentTime = p.completionTime;
+    }
+}
+
+template <typename Compare>
+constexpr void nonPreemptiveEngine(Process* processes, std::size_t n, Process** heap, Compare cmp) {
+    sortByArrival(processes, n);
+
+    std::size_t heapSize = 0;
+    int currentTime = 0;
+    std::size_t completed = 0;
+    std::size_t i = 0;
+
+    while (completed < n) {
+        for (; i < n && processes[i].arrivalTime <= currentTime; ++i) {
+            heap[heapSize++] = &processes[i];
+            std::push_heap(heap, heap + heapSize, cmp);
+        }
+
+        if (heapSize == 0) {
+            currentTime = processes[i].arrivalTime;
+            continue;
+        }
+
+        std::pop_heap(heap, heap + heapSize, cmp);
+        Process* p = heap[--heapSize];
+
+        if (p->responseTime == -1) {
+            p->responseTime = currentTime - p->arrivalTime;
+        }
+
+        p->completionTime = currentTime + p->burstTime;
+        p->turnaroundTime = p->completionTime - p->arrivalTime;
+        p->waitingTime = p->turnaroundTime - p->burstTime;
+        currentTime = p->completionTime;
+
+        completed++;
+    }
+}
+
+template <typename Compare>
+constexpr void preemptiveEngine(Process* processes, std::size_t n, Process** heap, Compare cmp) {
+    sortByArrival(processes, n);
+
+    std::size_t heapSize = 0;
+    int currentTime = 0;
+    std::size_t completed = 0;
+    std::size_t i = 0;
+
+    while (completed < n) {
+        for (; i < n && processes[i].arrivalTime <= currentTime; ++i) {
+            heap[heapSize++] = &processes[i];
+            std::push_heap(heap, heap + heapSize, cmp);
+        }
+
+        if (heapSize == 0) {
+            currentTime = processes[i].arrivalTime;
+            continue;
+        }
+
+        std::pop_heap(heap, heap + heapSize, cmp);
+        Process* p = heap[--heapSize];
+
+        if (p->responseTime == -1) {
+            p->responseTime = currentTime - p->arrivalTime;
+        }
+
+        int executionTime = (i < n) ? 
+            std::min(p->remainingTime, processes[i].arrivalTime - currentTime) : 
+            p->remainingTime;
+
+        p->remainingTime -= executionTime;
+        currentTime += executionTime;
+
+        if (p->remainingTime == 0) {
+            p->completionTime = currentTime;
+            p->turnaroundTime = p->completionTime - p->arrivalTime;
+            p->waitingTime = p->turnaroundTime - p->burstTime;
+            completed++;
+        } else {
+            heap[heapSize++] = p;
+            std::push_heap(heap, heap + heapSize, cmp);
+        }
+    }
+}
+
+constexpr void roundRobinEngine(Process* processes, std::size_t n, Process** ring, int timeQuantum) {
+    sortByArrival(processes, n);
+
+    // Every process is queued at most once, so a ring of n slots never overflows.
+    std::size_t head = 0;
+    std::size_t queued = 0;
+    auto push = [&](Process* p) { ring[(head + queued++) % n] = p; };
+
+    int currentTime = 0;
+    std::size_t completed = 0;
+    std::size_t i = 0;
+
+    while (completed < n) {
+        for (; i < n && processes[i].arrivalTime <= currentTime; ++i) {
+            push(&processes[i]);
+        }
+
+        if (queued == 0) {
+            currentTime = processes[i].arrivalTime;
+            continue;
+        }
+
+        Process* p = ring[head];
+        head = (head + 1) % n;
+        queued--;
+
+        if (p->responseTime == -1) {
+            p->responseTime = currentTime - p->arrivalTime;
+        }
+
+        int executionTime = std::min(timeQuantum, p->remainingTime);
+        p->remainingTime -= executionTime;
+        currentTime += executionTime;
+
+        for (; i < n && processes[i].arrivalTime <= currentTime; ++i) {
+            push(&processes[i]);
+        }
+
+        if (p->remainingTime > 0) {
+            push(p);
+        } else {
+            p->completionTime = currentTime;
+            p->turnaroundTime = p->completionTime - p->arrivalTime;
+            p->waitingTime = p->turnaroundTime - p->burstTime;
+            completed++;
+        }
+    }
+}
+
+// Heap orders matching the Scheduler classes' ready queues: ties go to the
+// process earlier in arrival order, which is the lower address once sorted.
+constexpr auto shortestBurst = [](const Process* a, const Process* b) {
+    return a->burstTime != b->burstTime ? a->burstTime > b->burstTime : a > b;
+};
+constexpr auto shortestRemaining = [](const Process* a, const Process* b) {
+    return a->remainingTime != b->remainingTime ? a->remainingTime > b->remainingTime : a > b;
+};
+constexpr auto highestPriority = [](const Process* a, const Process* b) {
+    return a->priority != b->priority ? a->priority < b->priority : a > b;
+};
+constexpr auto lowestPriority = [](const Process* a, const Process* b) {
+    return a->priority != b->priority ? a->priority > b->priority : a > b;
+};
+
+// Compile-time schedules for task sets known at build time.
+template <std::size_t N>
+constexpr std::array<Process, N> fcfsSchedule(std::array<Process, N> processes) {
+    fcfsEngine(processes.data(), N);
+    return processes;
+}
+
+template <std::size_t N>
+constexpr std::array<Process, N> sjfSchedule(std::array<Process, N> processes) {
+    std::array<Process*, N> heap{};
+    nonPreemptiveEngine(processes.data(), N, heap.data(), shortestBurst);
+    return processes;
+}
+
+template <std::size_t N>
+constexpr std::array<Process, N> prioritySchedule(std::array<Process, N> processes) {
+    std::array<Process*, N> heap{};
+    nonPreemptiveEngine(processes.data(), N, heap.data(), highestPriority);
+    return processes;
+}
+
+template <std::size_t N>
+constexpr std::array<Process, N> roundRobinSchedule(std::array<Process, N> processes, int timeQuantum) {
+    std::array<Process*, N> ring{};
+    roundRobinEngine(processes.data(), N, ring.data(), timeQuantum);
+    return processes;
+}
+
+// Fixed-capacity schedulers never allocate after construction: processes and
+// the ready queue live in caller-provided storage, or inline via InlineScheduler.
+class FixedCapacityScheduler {
+protected:
+    std::span<Process> storage;
+    std::span<Process*> readyQueue;
+    std::size_t count = 0;
+    ScheduleMetrics metrics{};
+
+public:
+    FixedCapacityScheduler(std::span<Process> storage, std::span<Process*> readyQueue)
+        : storage(storage), readyQueue(readyQueue.first(std::min(storage.size(), readyQueue.size()))) {}
+    virtual ~FixedCapacityScheduler() = default;
+
+    std::size_t capacity() const { return readyQueue.size(); }
+
+    // Returns false instead of growing when the scheduler is full.
+    bool addProcess(const Process& p) {
+        if (count == capacity()) {
+            return false;
+        }
+        storage[count++] = p;
+        return true;
+    }
+
+    void clear() { count = 0; }
+
+    std::span<const Process> results() const { return storage.first(count); }
+
+    virtual void schedule() = 0;
+
+    virtual void printResults() {
+        printSchedule(results(), metrics);
+    }
+};
+
+class FixedFCFSScheduler : public FixedCapacityScheduler {
+public:
+    using FixedCapacityScheduler::FixedCapacityScheduler;
+
+    void schedule() override {
+        fcfsEngine(storage.data(), count);
+        metrics = computeMetrics(results());
+    }
+
+    void printResults() override {
+        std::cout << "FCFS Scheduling Results:\n";
+        FixedCapacityScheduler::printResults();
+    }
+};
+
+class FixedSJFScheduler : public FixedCapacityScheduler {
+public:
+    using FixedCapacityScheduler::FixedCapacityScheduler;
+
+    void schedule() override {
+        nonPreemptiveEngine(storage.data(), count, readyQueue.data(), shortestBurst);
+        metrics = computeMetrics(results());
+    }
+
+    void printResults() override {
+        std::cout << "SJF Scheduling Results:\n";
+        FixedCapacityScheduler::printResults();
+    }
+};
+
+class FixedSRTFScheduler : public FixedCapacityScheduler {
+public:
+    using FixedCapacityScheduler::FixedCapacityScheduler;
+
+    void schedule() override {
+        preemptiveEngine(storage.data(), count, readyQueue.data(), shortestRemaining);
+        metrics = computeMetrics(results());
+    }
+
+    void printResults() override {
+        std::cout << "SRTF Scheduling Results:\n";
+        FixedCapacityScheduler::printResults();
+    }
+};
+
+class FixedRoundRobinScheduler : public FixedCapacityScheduler {
+private:
+    int timeQuantum;
+
+public:
+    FixedRoundRobinScheduler(std::span<Process> storage, std::span<Process*> readyQueue, int quantum)
+        : FixedCapacityScheduler(storage, readyQueue), timeQuantum(quantum) {}
+
+    void schedule() override {
+        roundRobinEngine(storage.data(), count, readyQueue.data(), timeQuantum);
+        metrics = computeMetrics(results());
+    }
+
+    void printResults() override {
+        std::cout << "Round Robin (Time Quantum: " << timeQuantum << ") Scheduling Results:\n";
+        FixedCapacityScheduler::printResults();
+    }
+};
+
+class FixedPriorityScheduler : public FixedCapacityScheduler {
+public:
+    using FixedCapacityScheduler::FixedCapacityScheduler;
+
+    void schedule() override {
+        nonPreemptiveEngine(storage.data(), count, readyQueue.data(), highestPriority);
+        metrics = computeMetrics(results());
+    }
+
+    void printResults() override {
+        std::cout << "Priority Scheduling Results:\n";
+        FixedCapacityScheduler::printResults();
+    }
+};
+
+class FixedPreemptivePriorityScheduler : public FixedCapacityScheduler {
+public:
+    using FixedCapacityScheduler::FixedCapacityScheduler;
+
+    void schedule() override {
+        preemptiveEngine(storage.data(), count, readyQueue.data(), lowestPriority);
+        metrics = computeMetrics(results());
+    }
+
+    void printResults() override {
+        std::cout << "Preemptive Priority Scheduling Results:\n";
+        FixedCapacityScheduler::printResults();
+    }
+};
+
+template <std::size_t Capacity>
+struct InlineBuffers {
+    std::array<Process, Capacity> storage{};
+    std::array<Process*, Capacity> readyQueue{};
+};
+
+// Buffers are a base so they exist before the policy is handed spans over them.
+template <typename Policy, std::size_t Capacity>
+class InlineScheduler : private InlineBuffers<Capacity>, public Policy {
+public:
+    template <typename... Args>
+    explicit InlineScheduler(Args... args)
+        : Policy(InlineBuffers<Capacity>::storage, InlineBuffers<Capacity>::readyQueue, args...) {}
+};
+
+constexpr std::array<Process, 5> sampleProcesses = {{
+    {1, 0, 10, 3},
+    {2, 1, 5, 1},
+    {3, 3, 8, 2},
+    {4, 5, 2, 4},
+    {5, 6, 4, 5}
+}};
+
+template <std::size_t N>
+constexpr bool completesAt(const std::array<Process, N>& results, const std::array<int, N>& expected) {
+    for (std::size_t k = 0; k < N; ++k) {
+        if (results[k].completionTime != expected[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(completesAt(fcfsSchedule(sampleProcesses), {10, 15, 23, 25, 29}));
+static_assert(completesAt(sjfSchedule(sampleProcesses), {10, 21, 29, 12, 16}));
+static_assert(completesAt(prioritySchedule(sampleProcesses), {10, 29, 24, 16, 14}));
+static_assert(completesAt(roundRobinSchedule(sampleProcesses, 2), {27, 19, 29, 12, 21}));
+static_assert(computeMetrics(fcfsSchedule(sampleProcesses)).avgWaitingTime == 58.0 / 5);
+static_assert(computeMetrics(sjfSchedule(sampleProcesses)).avgTurnaroundTime == 73.0 / 5);
+
+// Equal arrivals, bursts and priorities, in more rows than an insertion-sorted
+// small range, so every tie has to be broken by insertion order.
+constexpr std::array<Process, 24> tiedProcesses = [] {
+    std::array<Process, 24> processes{};
+    for (int k = 0; k < 24; ++k) {
+        processes[k] = Process(k + 1, (k * 7) % 3, 2, 1);
+    }
+    return processes;
+}();
+
+// Ties run in insertion order: by arrival, then id, one after another.
+template <std::size_t N>
+constexpr bool runsInInsertionOrder(const std::array<Process, N>& results) {
+    for (std::size_t k = 1; k < N; ++k) {
+        const Process& a = results[k - 1];
+        const Process& b = results[k];
+        if (a.arrivalTime > b.arrivalTime || (a.arrivalTime == b.arrivalTime && a.id > b.id) ||
+            a.completionTime >= b.completionTime) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(runsInInsertionOrder(fcfsSchedule(tiedProcesses)));
+static_assert(runsInInsertionOrder(roundRobinSchedule(tiedProcesses, 2)));
+static_assert(runsInInsertionOrder(sjfSchedule(tiedProcesses)));
+static_assert(runsInInsertionOrder(prioritySchedule(tiedProcesses)));
+
+#ifdef PROCESS_SCHEDULING_SELF_TEST
+// Runtime checks that cannot be static_asserts, run first by main() in a test
+// build:
+//
+//   g++ -std=c++20 -O2 -DPROCESS_SCHEDULING_SELF_TEST process_scheduling.cpp
+//
+// The test build counts global allocations, to check that the fixed-capacity
+// schedulers really never allocate.
+static std::atomic<std::size_t> allocationCount{0};
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// Kept out of line, or GCC sees free() paired with operator new.
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Allocations made while loading, running and reloading a scheduler twice.
+template <typename Policy, typename... Args>
+std::size_t allocationsDuringRuns(Args... args) {
+    InlineScheduler<Policy, sampleProcesses.size()> scheduler(args...);
+    std::size_t before = allocationCount.load(std::memory_order_relaxed);
+    for (int run = 0; run < 2; ++run) {
+        scheduler.clear();
+        for (const auto& p : sampleProcesses) {
+            scheduler.addProcess(p);
+        }
+        scheduler.schedule();
+    }
+    return allocationCount.load(std::memory_order_relaxed) - before;
+}
+
+inline std::size_t fixedSchedulerAllocations() {
+    return allocationsDuringRuns<FixedFCFSScheduler>() + allocationsDuringRuns<FixedSJFScheduler>() +
+           allocationsDuringRuns<FixedSRTFScheduler>() + allocationsDuringRuns<FixedRoundRobinScheduler>(2) +
+           allocationsDuringRuns<FixedPriorityScheduler>() + allocationsDuringRuns<FixedPreemptivePriorityScheduler>();
+}
+#endif
+
+// Coroutine processes: instead of a fixed burst, a process is a C++20
+// coroutine that co_awaits CpuBurst, IoWait or spawn(child) requests, and
+// CoroutineScheduler resumes it whenever the policy lets it run.
+// Frames come from a per-thread size-class pool, so simulating millions of
+// short-lived processes does not go through the global allocator each time.
+class FramePool {
+private:
+    static constexpr std::size_t granularity = 64;
+    static constexpr std::size_t maxPooledSize = 4096;
+    static constexpr std::size_t blockSize = 256 * 1024;
+
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    std::array<FreeNode*, maxPooledSize / granularity> freeLists{};
+    std::vector<std::unique_ptr<std::byte[]>> blocks;
+    std::byte* cursor = nullptr;
+    std::byte* limit = nullptr;
+
+    static FramePool& local() {
+        thread_local FramePool pool;
+        return pool;
+    }
+
+    static std::size_t sizeClass(std::size_t size) { return (size + granularity - 1) / granularity - 1; }
+
+public:
+    static void* allocate(std::size_t size) {
+        if (size > maxPooledSize) {
+            return ::operator new(size);
+        }
+        FramePool& pool = local();
+        std::size_t cls = sizeClass(size);
+        if (FreeNode* node = pool.freeLists[cls]) {
+            pool.freeLists[cls] = node->next;
+            return node;
+        }
+        std::size_t bytes = (cls + 1) * granularity;
+        if (static_cast<std::size_t>(pool.limit - pool.cursor) < bytes) {
+            pool.blocks.push_back(std::make_unique<std::byte[]>(blockSize));
+            pool.cursor = pool.blocks.back().get();
+            pool.limit = pool.cursor + blockSize;
+        }
+        void* frame = pool.cursor;
+        pool.cursor += bytes;
+        return frame;
+    }
+
+    static void deallocate(void* frame, std::size_t size) {
+        if (size > maxPooledSize) {
+            ::operator delete(frame);
+            return;
+        }
+        FramePool& pool = local();
+        std::size_t cls = sizeClass(size);
+        pool.freeLists[cls] = new (frame) FreeNode{pool.freeLists[cls]};
+    }
+};
+
+struct CpuBurst {
+    int time;
+};
+
+struct IoWait {
+    int time;
+};
+
+struct SpawnRequest;
+
+class SimProcess {
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    enum class RequestKind { None, Cpu, Io, Spawn };
+
+    struct promise_type {
+        RequestKind kind = RequestKind::None;
+        int amount = 0;
+        Handle spawned;
+        std::exception_ptr error;
+
+        SimProcess get_return_object() { return SimProcess(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+
+        std::suspend_always await_transform(CpuBurst burst) {
+            kind = RequestKind::Cpu;
+            amount = burst.time;
+            return {};
+        }
+
+        std::suspend_always await_transform(IoWait wait) {
+            kind = RequestKind::Io;
+            amount = wait.time;
+            return {};
+        }
+
+        std::suspend_always await_transform(SpawnRequest&& child);
+
+        static void* operator new(std::size_t size) { return FramePool::allocate(size); }
+        static void operator delete(void* frame, std::size_t size) { FramePool::deallocate(frame, size); }
+    };
+
+    SimProcess(SimProcess&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    SimProcess& operator=(SimProcess&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    ~SimProcess() { destroy(); }
+
+    Handle release() { return std::exchange(handle, {}); }
+
+private:
+    Handle handle;
+
+    explicit SimProcess(Handle h) : handle(h) {}
+
+    void destroy() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+};
+
+struct SpawnRequest {
+    SimProcess process;
+};
+
+// Use as `co_await spawn(child())`; the child arrives at the current time.
+inline SpawnRequest spawn(SimProcess child) {
+    return SpawnRequest{std::move(child)};
+}
+
+inline std::suspend_always SimProcess::promise_type::await_transform(SpawnRequest&& child) {
+    kind = RequestKind::Spawn;
+    spawned = child.process.release();
+    return {};
+}
+
+// Round Robin over coroutine processes. A quantum of 0 lets each process keep
+// the CPU until it waits for I/O or finishes (FCFS). Reported burst is the
+// total CPU a process asked for; waiting time excludes its I/O waits.
+// A run consumes the coroutines, so schedule() can be called only once.
+class CoroutineScheduler {
+private:
+    struct Task {
+        SimProcess::Handle handle;
+        Process record;
+        int pendingCpu = 0;
+        int ioTime = 0;
+    };
+
+    int timeQuantum;
+    std::vector<Task> tasks;
+    std::vector<std::size_t> arrivals;
+    ScheduleMetrics metrics{};
+    int nextId = 1;
+    bool scheduled = false;
+
+    void destroyAll() {
+        for (auto& t : tasks) {
+            if (t.handle) {
+                t.handle.destroy();
+                t.handle = {};
+            }
+        }
+    }
+
+public:
+    explicit CoroutineScheduler(int quantum = 0) : timeQuantum(quantum) {}
+    ~CoroutineScheduler() { destroyAll(); }
+
+    CoroutineScheduler(const CoroutineScheduler&) = delete;
+    CoroutineScheduler& operator=(const CoroutineScheduler&) = delete;
+
+    void reserve(std::size_t n) { tasks.reserve(n); }
+
+    void addProcess(int id, int arrival, SimProcess process, int priority = 0) {
+        tasks.push_back({process.release(), Process(id, arrival, 0, priority)});
+        nextId = std::max(nextId, id + 1);
+    }
+
+    auto results() const {
+        return tasks | std::views::transform([](const Task& t) -> const Process& { return t.record; });
+    }
+
+    // Throws std::logic_error when called a second time.
+    void schedule() {
+        if (std::exchange(scheduled, true)) {
+            throw std::logic_error("coroutine processes have already run");
+        }
+        arrivals.resize(tasks.size());
+        for (std::size_t k = 0; k < tasks.size(); ++k) {
+            arrivals[k] = k;
+        }
+        std::stable_sort(arrivals.begin(), arrivals.end(), [this](std::size_t a, std::size_t b) {
+            return tasks[a].record.arrivalTime < tasks[b].record.arrivalTime;
+        });
+
+        std::deque<std::size_t> readyQueue;
+        using Wakeup = std::pair<int, std::size_t>;
+        std::priority_queue<Wakeup, std::vector<Wakeup>, std::greater<Wakeup>> blocked;
+        std::size_t i = 0;
+        int currentTime = 0;
+
+        auto admit = [&] {
+            for (; i < arrivals.size() && tasks[arrivals[i]].record.arrivalTime <= currentTime; ++i) {
+                readyQueue.push_back(arrivals[i]);
+            }
+            while (!blocked.empty() && blocked.top().first <= currentTime) {
+                readyQueue.push_back(blocked.top().second);
+                blocked.pop();
+            }
+        };
+
+        // Resumes a process until it asks for CPU time, which takes no simulated
+        // time. Returns false once it has finished or is waiting for I/O.
+        auto resume = [&](std::size_t k) {
+            while (tasks[k].pendingCpu == 0) {
+                SimProcess::Handle h = tasks[k].handle;
+                h.resume();
+                auto& promise = h.promise();
+                if (promise.error) {
+                    std::rethrow_exception(promise.error);
+                }
+                if (h.done()) {
+                    Process& r = tasks[k].record;
+                    r.completionTime = currentTime;
+                    r.turnaroundTime = r.completionTime - r.arrivalTime;
+                    r.waitingTime = r.turnaroundTime - r.burstTime - tasks[k].ioTime;
+                    r.remainingTime = 0;
+                    if (r.responseTime == -1) {
+                        r.responseTime = r.turnaroundTime;
+                    }
+                    h.destroy();
+                    tasks[k].handle = {};
+                    return false;
+                }
+                auto kind = std::exchange(promise.kind, SimProcess::RequestKind::None);
+                if (kind == SimProcess::RequestKind::Cpu) {
+                    tasks[k].pendingCpu = std::max(promise.amount, 0);
+                    tasks[k].record.burstTime += tasks[k].pendingCpu;
+                } else if (kind == SimProcess::RequestKind::Io) {
+                    tasks[k].ioTime += promise.amount;
+                    blocked.push({currentTime + promise.amount, k});
+                    return false;
+                } else if (kind == SimProcess::RequestKind::Spawn) {
+                    auto child = std::exchange(promise.spawned, {});
+                    tasks.push_back({child, Process(nextId++, currentTime, 0)});
+                    readyQueue.push_back(tasks.size() - 1);
+                }
+            }
+            return true;
+        };
+
+        constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+        std::size_t running = none;
+        int quantumLeft = 0;
+
+        while (true) {
+            admit();
+
+            if (readyQueue.empty()) {
+                int next = std::numeric_limits<int>::max();
+                if (i < arrivals.size()) next = tasks[arrivals[i]].record.arrivalTime;
+                if (!blocked.empty()) next = std::min(next, blocked.top().first);
+                if (next == std::numeric_limits<int>::max()) break;
+                currentTime = next;
+                continue;
+            }
+
+            std::size_t k = readyQueue.front();
+            if (!resume(k)) {
+                readyQueue.pop_front();
+                running = none;
+                continue;
+            }
+            if (k != running) {
+                running = k;
+                quantumLeft = timeQuantum;
+            }
+
+            Task& t = tasks[k];
+            if (t.record.responseTime == -1) {
+                t.record.responseTime = currentTime - t.record.arrivalTime;
+            }
+
+            int executionTime = timeQuantum > 0 ? std::min(quantumLeft, t.pendingCpu) : t.pendingCpu;
+            t.pendingCpu -= executionTime;
+            quantumLeft -= executionTime;
+            currentTime += executionTime;
+
+            admit();
+
+            // A finished burst is followed straight away by the body's next request.
+            if (tasks[k].pendingCpu == 0 && !resume(k)) {
+                readyQueue.pop_front();
+                running = none;
+            } else if (timeQuantum > 0 && quantumLeft == 0) {
+                readyQueue.pop_front();
+                readyQueue.push_back(k);
+                running = none;
+            }
+        }
+        metrics = computeMetrics(results());
+    }
+
+    void printResults() {
+        if (timeQuantum > 0) {
+            std::cout << "Coroutine Round Robin (Time Quantum: " << timeQuantum << ") Scheduling Results:\n";
+        } else {
+            std::cout << "Coroutine FCFS Scheduling Results:\n";
+        }
+        printSchedule(results(), metrics);
+    }
+};
+
+// Runs real callables on worker threads, dispatched in the order of the same
+// policies: "fcfs", "sjf" (lowest estimated cost first) or "priority" (highest
+// priority first, as PriorityScheduler). Tasks are not preemptible, so "rr" and
+// "rr:<quantum>" dispatch like "fcfs". Submission is lock-free; picking the next
+// task holds a short dispatch lock, since the policy order needs a single heap.
+class TaskExecutor {
+public:
+    struct TaskTiming {
+        std::uint64_t id;
+        int estimatedCost;
+        int priority;
+        double queueingDelay;  // Microseconds from submit to start.
+        double responseTime;   // Microseconds from submit to finish.
+        bool failed;
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Task {
+        std::function<void()> work;
+        int estimatedCost;
+        int priority;
+        std::uint64_t id;
+        Clock::time_point submitted;
+        TaskTiming timing{};
+        Task* next = nullptr;
+    };
+
+    // Treiber stack: push is a CAS loop, takeAll detaches every node at once.
+    class AtomicStack {
+    private:
+        std::atomic<Task*> head{nullptr};
+
+    public:
+        void push(Task* t) {
+            t->next = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(t->next, t, std::memory_order_release, std::memory_order_relaxed)) {
+            }
+        }
+
+        Task* takeAll() { return head.exchange(nullptr, std::memory_order_acquire); }
+    };
+
+    enum class Policy { FCFS, SJF, Priority };
+
+    Policy policy;
+    AtomicStack inbox;
+    AtomicStack finished;
+    std::mutex dispatchLock;
+    std::vector<Task*> ready;
+    std::atomic<std::uint64_t> nextId{0};
+    std::atomic<std::uint64_t> signal{0};
+    std::atomic<std::size_t> outstanding{0};
+    std::atomic<bool> stopping{false};
+    std::vector<std::thread> workers;
+    std::vector<TaskTiming> timings;
+
+    bool before(const Task* a, const Task* b) const {
+        switch (policy) {
+        case Policy::SJF:
+            if (a->estimatedCost != b->estimatedCost) return a->estimatedCost > b->estimatedCost;
+            break;
+        case Policy::Priority:
+            if (a->priority != b->priority) return a->priority < b->priority;
+            break;
+        case Policy::FCFS:
+            break;
+        }
+        return a->id > b->id;
+    }
+
+    Task* takeNext() {
+        std::lock_guard<std::mutex> guard(dispatchLock);
+        auto cmp = [this](const Task* a, const Task* b) { return before(a, b); };
+        for (Task* t = inbox.takeAll(); t;) {
+            Task* next = t->next;
+            ready.push_back(t);
+            std::push_heap(ready.begin(), ready.end(), cmp);
+            t = next;
+        }
+        if (ready.empty()) {
+            return nullptr;
+        }
+        std::pop_heap(ready.begin(), ready.end(), cmp);
+        Task* t = ready.back();
+        ready.pop_back();
+        return t;
+    }
+
+    void run(Task* t) {
+        auto started = Clock::now();
+        bool failed = false;
+        try {
+            t->work();
+        } catch (...) {
+            failed = true;
+        }
+        auto done = Clock::now();
+        using Micros = std::chrono::duration<double, std::micro>;
+        t->timing = {t->id, t->estimatedCost, t->priority,
+                     Micros(started - t->submitted).count(), Micros(done - t->submitted).count(), failed};
+        t->work = nullptr;
+        finished.push(t);
+        if (outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            outstanding.notify_all();
+        }
+    }
+
+    void workerLoop() {
+        while (true) {
+            std::uint64_t seen = signal.load(std::memory_order_acquire);
+            if (Task* t = takeNext()) {
+                run(t);
+                continue;
+            }
+            if (stopping.load(std::memory_order_acquire)) {
+                return;
+            }
+            signal.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+public:
+    // Throws std::invalid_argument for an unknown policy spec.
+    explicit TaskExecutor(std::string_view spec, unsigned workerCount = std::thread::hardware_concurrency()) {
+        auto isRoundRobin = [](std::string_view spec) {
+            if (spec == "rr") return true;
+            if (!spec.starts_with("rr:")) return false;
+            int quantum = 0;
+            auto digits = spec.substr(3);
+            auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), quantum);
+            return ec == std::errc() && end == digits.data() + digits.size() && quantum > 0;
+        };
+        if (spec == "fcfs" || isRoundRobin(spec)) {
+            policy = Policy::FCFS;
+        } else if (spec == "sjf") {
+            policy = Policy::SJF;
+        } else if (spec == "priority") {
+            policy = Policy::Priority;
+        } else {
+            throw std::invalid_argument("unknown executor policy");
+        }
+        workerCount = std::max(workerCount, 1u);
+        workers.reserve(workerCount);
+        for (unsigned w = 0; w < workerCount; ++w) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~TaskExecutor() {
+        wait();
+        stopping.store(true, std::memory_order_release);
+        signal.fetch_add(1, std::memory_order_release);
+        signal.notify_all();
+        for (auto& w : workers) {
+            w.join();
+        }
+        collect();
+    }
+
+    TaskExecutor(const TaskExecutor&) = delete;
+    TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+    std::uint64_t submit(std::function<void()> work, int estimatedCost = 0, int priority = 0) {
+        std::uint64_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+        Task* t = new Task{std::move(work), estimatedCost, priority, id, Clock::now()};
+        outstanding.fetch_add(1, std::memory_order_relaxed);
+        // t may be run and collected as soon as it is pushed.
+        inbox.push(t);
+        signal.fetch_add(1, std::memory_order_release);
+        signal.notify_one();
+        return id;
+    }
+
+    // Blocks until every task submitted so far has finished.
+    void wait() {
+        for (std::size_t n = outstanding.load(std::memory_order_acquire); n != 0;
+             n = outstanding.load(std::memory_order_acquire)) {
+            outstanding.wait(n, std::memory_order_acquire);
+        }
+    }
+
+    // Moves the timings of finished tasks into the report, in completion order.
+    const std::vector<TaskTiming>& collect() {
+        std::size_t from = timings.size();
+        for (Task* t = finished.takeAll(); t;) {
+            Task* next = t->next;
+            timings.push_back(t->timing);
+            delete t;
+            t = next;
+        }
+        std::reverse(timings.begin() + from, timings.end());
+        return timings;
+    }
+
+    void printResults() {
+        collect();
+        std::cout << "Task\tCost\tPriority\tQueueing(us)\tResponse(us)\n";
+        double totalDelay = 0;
+        double totalResponse = 0;
+        for (const auto& t : timings) {
+            std::cout << t.id << "\t" << t.estimatedCost << "\t" << t.priority << "\t\t"
+                      << t.queueingDelay << "\t\t" << t.responseTime << (t.failed ? "\tfailed" : "") << "\n";
+            totalDelay += t.queueingDelay;
+            totalResponse += t.responseTime;
+        }
+        if (timings.empty()) {
+            return;
+        }
+        std::cout << "Average Queueing Delay: " << totalDelay / timings.size() << " us" << std::endl;
+        std::cout << "Average Response Time: " << totalResponse / timings.size() << " us" << std::endl;
+    }
+};
+
+#if PROCESS_SCHEDULING_HAS_FIBERS
+// Cooperative user-space fibers with Round Robin time slicing. Long-running
+// bodies call FiberRuntime::checkpoint() at safe points; it costs one timestamp
+// read and switches to the next fiber only once the quantum is used up.
+// Quanta are in TSC ticks on x86, otherwise steady_clock nanoseconds.
+class FiberRuntime {
+public:
+    struct FiberStats {
+        std::size_t id;
+        std::size_t slices;
+        std::uint64_t cpuTicks;
+        std::uint64_t completionTicks;  // Since run() started.
+    };
+
+private:
+    struct Fiber {
+        ucontext_t context;
+        std::unique_ptr<std::byte[]> stack;
+        std::function<void()> body;
+        std::exception_ptr error;
+        FiberStats stats{};
+        bool done = false;
+    };
+
+    std::uint64_t timeQuantum;
+    std::size_t stackSize;
+    // Fibers are pinned on the heap: a suspended ucontext_t must not move.
+    std::vector<std::unique_ptr<Fiber>> fibers;
+    std::deque<Fiber*> readyQueue;
+    ucontext_t schedulerContext;
+    Fiber* running = nullptr;
+    std::uint64_t deadline = 0;
+
+    static FiberRuntime*& current() {
+        thread_local FiberRuntime* runtime = nullptr;
+        return runtime;
+    }
+
+    static void trampoline() {
+        Fiber* f = current()->running;
+        try {
+            f->body();
+        } catch (...) {
+            f->error = std::current_exception();
+        }
+        f->done = true;
+    }
+
+public:
+    static std::uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    explicit FiberRuntime(std::uint64_t quantum, std::size_t stackSize = 64 * 1024)
+        : timeQuantum(quantum), stackSize(stackSize) {}
+
+    FiberRuntime(const FiberRuntime&) = delete;
+    FiberRuntime& operator=(const FiberRuntime&) = delete;
+
+    // May also be called from a running fiber; the new fiber joins the back of the queue.
+    void spawn(std::function<void()> body) {
+        auto f = std::make_unique<Fiber>();
+        f->body = std::move(body);
+        f->stack = std::make_unique<std::byte[]>(stackSize);
+        f->stats.id = fibers.size();
+        if (getcontext(&f->context) != 0) {
+            throw std::runtime_error("getcontext failed");
+        }
+        f->context.uc_stack.ss_sp = f->stack.get();
+        f->context.uc_stack.ss_size = stackSize;
+        f->context.uc_link = &schedulerContext;
+        makecontext(&f->context, &FiberRuntime::trampoline, 0);
+        readyQueue.push_back(f.get());
+        fibers.push_back(std::move(f));
+    }
+
+    // Gives up the rest of the quantum.
+    static void yield() {
+        FiberRuntime* rt = current();
+        swapcontext(&rt->running->context, &rt->schedulerContext);
+    }
+
+    // Safe point for long-running bodies.
+    static void checkpoint() {
+        FiberRuntime* rt = current();
+        if (rt && rt->running && ticks() >= rt->deadline) {
+            yield();
+        }
+    }
+
+    // Runs every fiber to completion on the calling thread.
+    void run() {
+        FiberRuntime* previous = std::exchange(current(), this);
+        std::uint64_t start = ticks();
+        while (!readyQueue.empty()) {
+            Fiber* f = readyQueue.front();
+            readyQueue.pop_front();
+
+            running = f;
+            std::uint64_t sliceStart = ticks();
+            deadline = sliceStart + timeQuantum;
+            swapcontext(&schedulerContext, &f->context);
+            std::uint64_t sliceEnd = ticks();
+            running = nullptr;
+
+            f->stats.slices++;
+            f->stats.cpuTicks += sliceEnd - sliceStart;
+            if (f->done) {
+                f->stats.completionTicks = sliceEnd - start;
+                f->stack.reset();
+                if (f->error) {
+                    current() = previous;
+                    std::rethrow_exception(f->error);
+                }
+            } else {
+                readyQueue.push_back(f);
+            }
+        }
+        current() = previous;
+    }
+
+    std::vector<FiberStats> stats() const {
+        std::vector<FiberStats> result;
+        result.reserve(fibers.size());
+        for (const auto& f : fibers) {
+            result.push_back(f->stats);
+        }
+        return result;
+    }
+
+    void printResults() const {
+        std::cout << "Fiber Round Robin (Time Quantum: " << timeQuantum << " ticks) Results:\n";
+        std::cout << "Fiber\tSlices\tCPU Ticks\tCompletion Ticks\n";
+        for (const auto& f : fibers) {
+            std::cout << f->stats.id << "\t" << f->stats.slices << "\t" << f->stats.cpuTicks << "\t"
+                      << f->stats.completionTicks << "\n";
+        }
+    }
+};
+#endif
+
+// Splits streamed text into lines for the trace readers, carrying a partial
+// last line over to the next chunk.
+class LineStream {
+private:
+    std::string partialLine;
+
+public:
+    template <typename OnLine>
+    void feed(std::string_view chunk, OnLine onLine) {
+        if (!partialLine.empty()) {
+            std::size_t newline = chunk.find('\n');
+            if (newline == std::string_view::npos) {
+                partialLine.append(chunk);
+                return;
+            }
+            partialLine.append(chunk.substr(0, newline));
+            onLine(std::string_view(partialLine));
+            partialLine.clear();
+            chunk.remove_prefix(newline + 1);
+        }
+        while (!chunk.empty()) {
+            const void* hit = std::memchr(chunk.data(), '\n', chunk.size());
+            if (!hit) {
+                partialLine.assign(chunk);
+                return;
+            }
+            std::size_t newline = static_cast<const char*>(hit) - chunk.data();
+            if (newline > 0) onLine(chunk.substr(0, newline));
+            chunk.remove_prefix(newline + 1);
+        }
+    }
+
+    template <typename OnLine>
+    void finish(OnLine onLine) {
+        if (!partialLine.empty()) {
+            onLine(std::string_view(partialLine));
+            partialLine.clear();
+        }
+    }
+};
+
+// Reads a file in 1 MB chunks; returns false if it cannot be opened or read.
+template <typename OnChunk>
+bool streamFile(const char* path, OnChunk onChunk) {
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::fopen(path, "rb"), &std::fclose);
+    if (!file) return false;
+    std::vector<char> buffer(1 << 20);
+    std::size_t n;
+    while ((n = std::fread(buffer.data(), 1, buffer.size(), file.get())) > 0) {
+        onChunk(std::string_view(buffer.data(), n));
+    }
+    return !std::ferror(file.get());
+}
+
+// Replays ftrace / trace-cmd text traces. Every stretch in which a task is
+// runnable, from sched_wakeup until it switches out asleep or exits, becomes one
+// process: arrival is the wakeup, burst is the CPU time it got and id is the
+// PID. Tasks that never reached the CPU are dropped. Bursts are handed to the
+// sink as they end, so arbitrarily large traces stream through a fixed-size
+// buffer. Times are relative to the first event, in ticks of 1/ticksPerSecond
+// seconds.
+//
+// The kernel prio (0-139) runs lowest first. HighestFirst maps it to
+// 139 - prio for PriorityScheduler; LowestFirst keeps it for the policies that
+// run the lowest value first, such as PreemptivePriorityScheduler.
+enum class FtracePriorityOrder { HighestFirst, LowestFirst };
+
+class FtraceImporter {
+public:
+    using Sink = std::function<void(const ProcessInput&)>;
+
+private:
+    struct TaskState {
+        std::int64_t arrival = 0;
+        std::int64_t runStart = 0;
+        std::int64_t cpu = 0;
+        int priority = 0;
+        bool running = false;
+        bool ran = false;
+    };
+
+    static constexpr int lowestKernelPriority = 139;
+
+    Sink sink;
+    std::int64_t ticksPerSecond;
+    FtracePriorityOrder priorityOrder;
+    std::int64_t origin = -1;
+    std::unordered_map<int, TaskState> active;
+    LineStream lines;
+
+    static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+    static int parseInt(std::string_view text) {
+        int value = 0;
+        std::from_chars(text.data(), text.data() + text.size(), value);
+        return value;
+    }
+
+    // Value of `key=` in a key=value field list, up to the next blank.
+    static std::string_view field(std::string_view fields, std::string_view key) {
+        for (std::size_t pos = fields.find(key); pos != std::string_view::npos; pos = fields.find(key, pos + 1)) {
+            if ((pos == 0 || isSpace(fields[pos - 1])) && pos + key.size() < fields.size() && fields[pos + key.size()] == '=') {
+                std::size_t start = pos + key.size() + 1;
+                std::size_t end = start;
+                while (end < fields.size() && !isSpace(fields[end])) ++end;
+                return fields.substr(start, end - start);
+            }
+        }
+        return {};
+    }
+
+    // trace-cmd's compact "comm:pid [prio]" form; comm may contain spaces or colons.
+    static bool compactTask(std::string_view text, int& pid, int& priority) {
+        std::size_t bracket = text.find(" [");
+        if (bracket == std::string_view::npos) return false;
+        std::size_t colon = text.rfind(':', bracket);
+        if (colon == std::string_view::npos) return false;
+        pid = parseInt(text.substr(colon + 1, bracket - colon - 1));
+        priority = parseInt(text.substr(bracket + 2));
+        return true;
+    }
+
+    std::int64_t parseTimestamp(std::string_view text) const {
+        std::size_t dot = text.find('.');
+        std::int64_t seconds = 0;
+        std::from_chars(text.data(), text.data() + std::min(dot, text.size()), seconds);
+        std::int64_t fraction = 0;
+        std::int64_t scale = 1;
+        if (dot != std::string_view::npos) {
+            for (std::size_t k = dot + 1; k < text.size() && scale < 1000000000; ++k) {
+                fraction = fraction * 10 + (text[k] - '0');
+                scale *= 10;
+            }
+        }
+        return seconds * ticksPerSecond + fraction * ticksPerSecond / scale;
+    }
+
+    int toTime(std::int64_t ticks) const {
+        if (ticks > std::numeric_limits<int>::max()) {
+            throw std::range_error("trace too long for the tick resolution");
+        }
+        return static_cast<int>(ticks);
+    }
+
+    void wakeup(int pid, int priority, std::int64_t now) {
+        if (pid == 0 || active.count(pid)) return;
+        active[pid] = {now, 0, 0, priority, false};
+    }
+
+    void switchOut(int pid, bool stillRunnable, std::int64_t now) {
+        auto it = active.find(pid);
+        if (pid == 0 || it == active.end()) return;
+        TaskState& t = it->second;
+        if (t.running) {
+            t.cpu += now - t.runStart;
+            t.running = false;
+        }
+        if (!stillRunnable) {
+            emit(pid, t);
+            active.erase(it);
+        }
+    }
+
+    void switchIn(int pid, int priority, std::int64_t now) {
+        if (pid == 0) return;
+        auto [it, inserted] = active.try_emplace(pid, TaskState{now, 0, 0, priority, false});
+        it->second.running = true;
+        it->second.ran = true;
+        it->second.runStart = now;
+    }
+
+    void emit(int pid, const TaskState& t) {
+        if (!t.ran) return;
+        int priority = priorityOrder == FtracePriorityOrder::HighestFirst ? lowestKernelPriority - t.priority : t.priority;
+        // Anything that reached the CPU ran for at least one tick.
+        sink({pid, toTime(t.arrival), toTime(std::max<std::int64_t>(t.cpu, 1)), priority});
+    }
+
+    void parseLine(std::string_view line) {
+        std::size_t marker = line.find(": sched_");
+        if (marker == std::string_view::npos || line.front() == '#') return;
+
+        std::size_t tsStart = marker;
+        while (tsStart > 0 && !isSpace(line[tsStart - 1])) --tsStart;
+        std::int64_t now = parseTimestamp(line.substr(tsStart, marker - tsStart));
+        if (origin < 0) origin = now;
+        now -= origin;
+
+        std::string_view rest = line.substr(marker + 2);
+        std::size_t colon = rest.find(':');
+        if (colon == std::string_view::npos) return;
+        std::string_view event = rest.substr(0, colon);
+        std::string_view fields = rest.substr(colon + 1);
+        while (!fields.empty() && isSpace(fields.front())) fields.remove_prefix(1);
+
+        if (event == "sched_wakeup" || event == "sched_wakeup_new") {
+            int pid = 0;
+            int priority = 0;
+            if (std::string_view v = field(fields, "pid"); !v.empty()) {
+                pid = parseInt(v);
+                priority = parseInt(field(fields, "prio"));
+            } else if (!compactTask(fields, pid, priority)) {
+                return;
+            }
+            wakeup(pid, priority, now);
+        } else if (event == "sched_switch") {
+            int prevPid = 0;
+            int prevPriority = 0;
+            int nextPid = 0;
+            int nextPriority = 0;
+            std::string_view prevState;
+            if (std::string_view v = field(fields, "prev_pid"); !v.empty()) {
+                prevPid = parseInt(v);
+                prevState = field(fields, "prev_state");
+                nextPid = parseInt(field(fields, "next_pid"));
+                nextPriority = parseInt(field(fields, "next_prio"));
+            } else {
+                std::size_t arrow = fields.find(" ==> ");
+                if (arrow == std::string_view::npos) return;
+                std::string_view prev = fields.substr(0, arrow);
+                if (!compactTask(prev, prevPid, prevPriority) || !compactTask(fields.substr(arrow + 5), nextPid, nextPriority)) {
+                    return;
+                }
+                prevState = prev.substr(prev.rfind(' ') + 1);
+            }
+            // R and R+ mean the task was preempted and is still runnable.
+            switchOut(prevPid, !prevState.empty() && prevState.front() == 'R', now);
+            switchIn(nextPid, nextPriority, now);
+        } else if (event == "sched_process_exit") {
+            int pid = 0;
+            int priority = 0;
+            if (std::string_view v = field(fields, "pid"); !v.empty()) {
+                pid = parseInt(v);
+            } else if (!compactTask(fields, pid, priority)) {
+                return;
+            }
+            switchOut(pid, false, now);
+        }
+    }
+
+public:
+    explicit FtraceImporter(Sink sink, std::int64_t ticksPerSecond = 1000000,
+                            FtracePriorityOrder priorityOrder = FtracePriorityOrder::HighestFirst)
+        : sink(std::move(sink)), ticksPerSecond(ticksPerSecond), priorityOrder(priorityOrder) {}
+
+    void feed(std::string_view chunk) {
+        lines.feed(chunk, [this](std::string_view line) { parseLine(line); });
+    }
+
+    // Ends the trace: tasks still runnable that have run are emitted with the
+    // CPU time seen so far.
+    void finish(std::int64_t endTicks = -1) {
+        lines.finish([this](std::string_view line) { parseLine(line); });
+        std::vector<int> pids;
+        pids.reserve(active.size());
+        for (const auto& entry : active) pids.push_back(entry.first);
+        std::sort(pids.begin(), pids.end());
+        for (int pid : pids) {
+            TaskState& t = active[pid];
+            if (t.running && endTicks >= 0) t.cpu += endTicks - t.runStart;
+            emit(pid, t);
+        }
+        active.clear();
+    }
+
+    // Streams a whole file through feed(); returns false if it cannot be read.
+    bool importFile(const char* path) {
+        bool ok = streamFile(path, [this](std::string_view chunk) { feed(chunk); });
+        finish();
+        return ok;
+    }
+};
+
+// Loads a trace into an arrival-ordered table ready for Scheduler::setInput().
+inline std::shared_ptr<const ProcessTable> readFtrace(const char* path, std::int64_t ticksPerSecond = 1000000,
+                                                     FtracePriorityOrder priorityOrder = FtracePriorityOrder::HighestFirst) {
+    auto table = std::make_shared<ProcessTable>();
+    FtraceImporter importer([&](const ProcessInput& p) { table->push_back(p); }, ticksPerSecond, priorityOrder);
+    if (!importer.importFile(path)) {
+        throw std::runtime_error(std::string("cannot read trace ") + path);
+    }
+    sortByArrival(*table);
+    return table;
+}
+
+// Standard Workload Format (Parallel Workloads Archive, version 2.2). Submit
+// time maps to arrivalTime, run time to burstTime and the queue (or partition)
+// number to priority. Jobs with an unknown run time are skipped. Lines are
+// handed on one at a time, so memory does not grow with the log.
+struct SwfJob {
+    ProcessInput process;
+    int requestedProcessors;
+};
+
+enum class SwfPriorityField { Queue, Partition };
+
+class SwfReader {
+public:
+    using Sink = std::function<void(const SwfJob&)>;
+
+private:
+    static constexpr int fieldCount = 18;
+    // Zero-based SWF field positions.
+    enum { JobNumber = 0, SubmitTime = 1, RunTime = 3, AllocatedProcessors = 4, RequestedProcessors = 7,
+           QueueNumber = 14, PartitionNumber = 15 };
+
+    Sink sink;
+    SwfPriorityField priorityField;
+    LineStream lines;
+    std::size_t skipped = 0;
+
+    void parseLine(std::string_view line) {
+        const char* p = line.data();
+        const char* end = p + line.size();
+        while (p < end && (*p == ' ' || *p == '\t')) ++p;
+        if (p == end || *p == ';' || *p == '\r') return;
+
+        std::array<long long, fieldCount> f;
+        f.fill(-1);
+        for (int k = 0; k < fieldCount && p < end; ++k) {
+            // Some archive logs write fractional seconds; the fraction is dropped.
+            auto [next, ec] = std::from_chars(p, end, f[k]);
+            if (ec != std::errc()) {
+                skipped++;
+                return;
+            }
+            p = next;
+            while (p < end && *p != ' ' && *p != '\t') ++p;
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+        }
+
+        if (f[RunTime] < 0 || f[SubmitTime] < 0 ||
+            f[SubmitTime] > std::numeric_limits<int>::max() || f[RunTime] > std::numeric_limits<int>::max()) {
+            skipped++;
+            return;
+        }
+        long long processors = f[RequestedProcessors] > 0 ? f[RequestedProcessors] : f[AllocatedProcessors];
+        long long priority = priorityField == SwfPriorityField::Queue ? f[QueueNumber] : f[PartitionNumber];
+        sink({{static_cast<int>(f[JobNumber]), static_cast<int>(f[SubmitTime]), static_cast<int>(f[RunTime]),
+               static_cast<int>(priority)},
+              static_cast<int>(std::max(processors, 1LL))});
+    }
+
+public:
+    explicit SwfReader(Sink sink, SwfPriorityField priorityField = SwfPriorityField::Queue)
+        : sink(std::move(sink)), priorityField(priorityField) {}
+
+    void feed(std::string_view chunk) {
+        lines.feed(chunk, [this](std::string_view line) { parseLine(line); });
+    }
+
+    void finish() {
+        lines.finish([this](std::string_view line) { parseLine(line); });
+    }
+
+    bool importFile(const char* path) {
+        bool ok = streamFile(path, [this](std::string_view chunk) { feed(chunk); });
+        finish();
+        return ok;
+    }
+
+    // Lines that were malformed or had no run time.
+    std::size_t skippedJobs() const { return skipped; }
+};
+
+inline std::shared_ptr<const ProcessTable> readSwf(const char* path, SwfPriorityField priorityField = SwfPriorityField::Queue) {
+    auto table = std::make_shared<ProcessTable>();
+    SwfReader reader([&](const SwfJob& job) { table->push_back(job.process); }, priorityField);
+    if (!reader.importFile(path)) {
+        throw std::runtime_error(std::string("cannot read workload ") + path);
+    }
+    sortByArrival(*table);
+    return table;
+}
+
+// Writes scheduled processes as SWF, one line at a time. The wait time column
+// is the scheduler's waiting time; fields the simulation does not model are -1.
+class SwfWriter {
+private:
+    std::ostream& out;
+    SwfPriorityField priorityField;
+
+public:
+    explicit SwfWriter(std::ostream& out, SwfPriorityField priorityField = SwfPriorityField::Queue)
+        : out(out), priorityField(priorityField) {}
+
+    void writeHeader(std::string_view note, std::size_t jobCount) {
+        out << "; Version: 2.2\n"
+            << "; Computer: ProcessSchedulingAlgorithms simulation\n"
+            << "; MaxJobs: " << jobCount << "\n"
+            << "; MaxRecords: " << jobCount << "\n";
+        if (!note.empty()) {
+            out << "; Note: " << note << "\n";
+        }
+    }
+
+    void write(const Process& p, int processors = 1) {
+        int queue = priorityField == SwfPriorityField::Queue ? p.priority : -1;
+        int partition = priorityField == SwfPriorityField::Partition ? p.priority : -1;
+        bool completed = p.completionTime > 0 || p.remainingTime == 0;
+        out << p.id << ' ' << p.arrivalTime << ' ' << (completed ? p.waitingTime : -1) << ' ' << p.burstTime << ' '
+            << processors << " -1 -1 " << processors << " -1 -1 " << (completed ? 1 : 5) << " -1 -1 -1 "
+            << queue << ' ' << partition << " -1 -1\n";
+    }
+
+    // Exports a scheduler's results in arrival order.
+    void write(const Scheduler& scheduler, std::string_view note = {}) {
+        writeHeader(note, scheduler.size());
+        for (const auto& p : scheduler.results()) {
+            write(p);
+        }
+    }
+};
+
+// Stream VByte integer coding: two length bits per value in a control stream,
+// 1-4 data bytes per value in a data stream. Decoding a group of four is a
+// single byte shuffle, chosen at runtime when the CPU has SSSE3.
+class StreamVByte {
+private:
+    struct Tables {
+        std::array<std::array<std::uint8_t, 16>, 256> shuffle;
+        std::array<std::uint8_t, 256> length;
+    };
+
+    static constexpr Tables makeTables() {
+        Tables t{};
+        for (int c = 0; c < 256; ++c) {
+            int offset = 0;
+            for (int j = 0; j < 4; ++j) {
+                int len = ((c >> (2 * j)) & 3) + 1;
+                for (int b = 0; b < 4; ++b) {
+                    t.shuffle[c][4 * j + b] = b < len ? static_cast<std::uint8_t>(offset + b) : 0xFF;
+                }
+                offset += len;
+            }
+            t.length[c] = static_cast<std::uint8_t>(offset);
+        }
+        return t;
+    }
+
+    static const Tables& tables() {
+        static constexpr Tables t = makeTables();
+        return t;
+    }
+
+    static int byteLength(std::uint32_t v) { return v < (1u << 8) ? 1 : v < (1u << 16) ? 2 : v < (1u << 24) ? 3 : 4; }
+
+    static const std::uint8_t* decodeScalar(const std::uint8_t* control, const std::uint8_t* data,
+                                            std::size_t from, std::size_t count, std::uint32_t* out) {
+        for (std::size_t k = from; k < count; ++k) {
+            int len = ((control[k / 4] >> (2 * (k % 4))) & 3) + 1;
+            std::uint32_t v = 0;
+            for (int b = 0; b < len; ++b) {
+                v |= static_cast<std::uint32_t>(data[b]) << (8 * b);
+            }
+            out[k] = v;
+            data += len;
+        }
+        return data;
+    }
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    __attribute__((target("ssse3")))
+    static void decodeSsse3(const std::uint8_t* control, const std::uint8_t* data, std::size_t count, std::uint32_t* out) {
+        const Tables& t = tables();
+        std::size_t groups = count / 4;
+        for (std::size_t g = 0; g < groups; ++g) {
+            std::uint8_t c = control[g];
+            __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.shuffle[c].data()));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * g), _mm_shuffle_epi8(in, mask));
+            data += t.length[c];
+        }
+        decodeScalar(control, data, groups * 4, count, out);
+    }
+#endif
+
+public:
+    // Extra readable bytes the decoder needs after the data stream.
+    static constexpr std::size_t padding = 16;
+
+    static std::size_t controlBytes(std::size_t count) { return (count + 3) / 4; }
+
+    // Number of data bytes the control stream says `count` values take.
+    static std::size_t dataBytes(const std::uint8_t* control, std::size_t count) {
+        const Tables& t = tables();
+        std::size_t total = 0;
+        for (std::size_t g = 0; g < count / 4; ++g) {
+            total += t.length[control[g]];
+        }
+        for (std::size_t k = count / 4 * 4; k < count; ++k) {
+            total += ((control[k / 4] >> (2 * (k % 4))) & 3) + 1;
+        }
+        return total;
+    }
+
+    // Appends control and data bytes; returns the number of data bytes written.
+    static std::size_t encode(const std::uint32_t* in, std::size_t count,
+                              std::vector<std::uint8_t>& control, std::vector<std::uint8_t>& data) {
+        std::size_t controlStart = control.size();
+        std::size_t dataStart = data.size();
+        control.resize(controlStart + controlBytes(count), 0);
+        for (std::size_t k = 0; k < count; ++k) {
+            int len = byteLength(in[k]);
+            control[controlStart + k / 4] |= static_cast<std::uint8_t>((len - 1) << (2 * (k % 4)));
+            for (int b = 0; b < len; ++b) {
+                data.push_back(static_cast<std::uint8_t>(in[k] >> (8 * b)));
+            }
+        }
+        return data.size() - dataStart;
+    }
+
+    // `data` must be followed by `padding` readable bytes.
+    static void decode(const std::uint8_t* control, const std::uint8_t* data, std::size_t count, std::uint32_t* out) {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+        static const bool hasSsse3 = __builtin_cpu_supports("ssse3");
+        if (hasSsse3) {
+            decodeSsse3(control, data, count, out);
+            return;
+        }
+#endif
+        decodeScalar(control, data, 0, count, out);
+    }
+};
+
+// Compressed process traces. Rows are stored in blocks of up to 4096. Within a
+// block, id and arrivalTime are delta-coded against the previous row, and every
+// column is zigzag-mapped then Stream VByte packed. A block with zero rows ends
+// the trace. Each block decodes on its own.
+//
+//   file:   "PSTRACE1" block* u32(0)
+//   block:  u32 rows, then per column (id, arrival, burst, priority):
+//           u32 dataBytes, control[(rows + 3) / 4], data[dataBytes]
+class CompressedTraceWriter {
+public:
+    static constexpr std::size_t blockSize = 4096;
+
+private:
+    std::ostream& out;
+    std::vector<ProcessInput> block;
+    std::vector<std::uint32_t> column;
+    std::vector<std::uint8_t> control;
+    std::vector<std::uint8_t> data;
+
+    static std::uint32_t zigzag(std::int32_t v) {
+        return (static_cast<std::uint32_t>(v) << 1) ^ static_cast<std::uint32_t>(v >> 31);
+    }
+
+    void writeU32(std::uint32_t v) {
+        char bytes[4] = {static_cast<char>(v), static_cast<char>(v >> 8), static_cast<char>(v >> 16), static_cast<char>(v >> 24)};
+        out.write(bytes, 4);
+    }
+
+    template <typename Field>
+    void writeColumn(Field field, bool delta) {
+        column.clear();
+        std::int64_t previous = 0;
+        for (const auto& p : block) {
+            std::int64_t v = field(p);
+            column.push_back(zigzag(static_cast<std::int32_t>(delta ? v - previous : v)));
+            previous = v;
+        }
+        control.clear();
+        data.clear();
+        StreamVByte::encode(column.data(), column.size(), control, data);
+        writeU32(static_cast<std::uint32_t>(data.size()));
+        out.write(reinterpret_cast<const char*>(control.data()), control.size());
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    void flush() {
+        if (block.empty()) return;
+        writeU32(static_cast<std::uint32_t>(block.size()));
+        writeColumn([](const ProcessInput& p) { return p.id; }, true);
+        writeColumn([](const ProcessInput& p) { return p.arrivalTime; }, true);
+        writeColumn([](const ProcessInput& p) { return p.burstTime; }, false);
+        writeColumn([](const ProcessInput& p) { return p.priority; }, false);
+        block.clear();
+    }
+
+public:
+    explicit CompressedTraceWriter(std::ostream& out) : out(out) {
+        out.write("PSTRACE1", 8);
+        block.reserve(blockSize);
+    }
+
+    void add(const ProcessInput& p) {
+        block.push_back(p);
+        if (block.size() == blockSize) flush();
+    }
+
+    void add(std::span<const ProcessInput> rows) {
+        for (const auto& p : rows) add(p);
+    }
+
+    // Writes the last partial block and the end marker.
+    void finish() {
+        flush();
+        writeU32(0);
+        out.flush();
+    }
+};
+
+class CompressedTraceReader {
+private:
+    std::istream& in;
+    std::vector<std::uint8_t> payload;
+    std::vector<std::uint32_t> column;
+    bool ended = false;
+
+    std::uint32_t readU32() {
+        unsigned char bytes[4];
+        if (!in.read(reinterpret_cast<char*>(bytes), 4)) {
+            throw std::runtime_error("truncated compressed trace");
+        }
+        return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+    }
+
+    static std::int32_t unzigzag(std::uint32_t v) {
+        return static_cast<std::int32_t>((v >> 1) ^ (~(v & 1) + 1));
+    }
+
+    // Decodes one column of `rows` values into `column`.
+    void readColumn(std::size_t rows) {
+        std::size_t dataBytes = readU32();
+        std::size_t controlBytes = StreamVByte::controlBytes(rows);
+        if (dataBytes > rows * 4) {
+            throw std::runtime_error("corrupt compressed trace");
+        }
+        payload.resize(controlBytes + dataBytes + StreamVByte::padding);
+        if (!in.read(reinterpret_cast<char*>(payload.data()), controlBytes + dataBytes)) {
+            throw std::runtime_error("truncated compressed trace");
+        }
+        if (StreamVByte::dataBytes(payload.data(), rows) != dataBytes) {
+            throw std::runtime_error("corrupt compressed trace");
+        }
+        column.resize(rows);
+        StreamVByte::decode(payload.data(), payload.data() + controlBytes, rows, column.data());
+    }
+
+public:
+    explicit CompressedTraceReader(std::istream& in) : in(in) {
+        char magic[8];
+        if (!in.read(magic, 8) || std::string_view(magic, 8) != "PSTRACE1") {
+            throw std::runtime_error("not a compressed process trace");
+        }
+    }
+
+    // Replaces `rows` with the next block; returns false after the last one.
+    bool next(std::vector<ProcessInput>& rows) {
+        rows.clear();
+        if (ended) return false;
+        std::size_t count = readU32();
+        if (count == 0) {
+            ended = true;
+            return false;
+        }
+        if (count > CompressedTraceWriter::blockSize) {
+            throw std::runtime_error("corrupt compressed trace");
+        }
+        rows.resize(count);
+
+        // Deltas wrap modulo 2^32, so they are summed unsigned.
+        readColumn(count);
+        std::uint32_t previous = 0;
+        for (std::size_t k = 0; k < count; ++k) {
+            previous += static_cast<std::uint32_t>(unzigzag(column[k]));
+            rows[k].id = static_cast<std::int32_t>(previous);
+        }
+        readColumn(count);
+        previous = 0;
+        for (std::size_t k = 0; k < count; ++k) {
+            previous += static_cast<std::uint32_t>(unzigzag(column[k]));
+            rows[k].arrivalTime = static_cast<std::int32_t>(previous);
+        }
+        readColumn(count);
+        for (std::size_t k = 0; k < count; ++k) {
+            rows[k].burstTime = unzigzag(column[k]);
+        }
+        readColumn(count);
+        for (std::size_t k = 0; k < count; ++k) {
+            rows[k].priority = unzigzag(column[k]);
+        }
+        return true;
+    }
+};
+
+inline void writeCompressedTrace(const char* path, const ProcessTable& table) {
+    std::ofstream out(path, std::ios::binary);
+    CompressedTraceWriter writer(out);
+    writer.add(table);
+    writer.finish();
+    if (!out) {
+        throw std::runtime_error(std::string("cannot write trace ") + path);
+    }
+}
+
+inline std::shared_ptr<const ProcessTable> readCompressedTrace(const char* path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error(std::string("cannot read trace ") + path);
+    }
+    auto table = std::make_shared<ProcessTable>();
+    CompressedTraceReader reader(in);
+    std::vector<ProcessInput> block;
+    while (reader.next(block)) {
+        std::size_t from = table->size();
+        table->insert(table->end(), block.begin(), block.end());
+        sortByArrival(*table, from);
+    }
+    return table;
+}
+
+// C ABI declared in process_scheduling.h. Exceptions never cross it.
+static_assert(std::is_same_v<int, std::int32_t>, "result columns are exported as int32_t");
+
+struct ps_scheduler {
+    std::unique_ptr<Scheduler> impl;
+    bool scheduled = false;
+};
+
+extern "C" {
+
+uint32_t ps_abi_version(void) {
+    return PS_ABI_VERSION;
+}
+
+ps_scheduler* ps_scheduler_create(const char* policy) {
+    if (!policy) {
+        return nullptr;
+    }
+    try {
+        auto impl = makeScheduler(policy);
+        return impl ? new ps_scheduler{std::move(impl)} : nullptr;
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void ps_scheduler_destroy(ps_scheduler* scheduler) {
+    delete scheduler;
+}
+
+int ps_scheduler_reserve(ps_scheduler* scheduler, size_t count) {
+    if (!scheduler) {
+        return PS_ERROR_INVALID_ARGUMENT;
+    }
+    // Reserving drops the results of the previous run.
+    scheduler->scheduled = false;
+    try {
+        scheduler->impl->reserve(count);
+    } catch (const std::exception&) {
+        return PS_ERROR_OUT_OF_MEMORY;
+    }
+    return PS_OK;
+}
+
+int ps_scheduler_add_processes(ps_scheduler* scheduler, const ps_process* processes, size_t count) {
+    if (!scheduler || (!processes && count > 0)) {
+        return PS_ERROR_INVALID_ARGUMENT;
+    }
+    try {
+        ProcessTable rows;
+        rows.reserve(count);
+        for (size_t k = 0; k < count; ++k) {
+            const ps_process& p = processes[k];
+            rows.push_back({p.id, p.arrival_time, p.burst_time, p.priority});
+        }
+        scheduler->impl->addProcesses(std::move(rows));
+    } catch (const std::exception&) {
+        return PS_ERROR_OUT_OF_MEMORY;
+    }
+    scheduler->scheduled = false;
+    return PS_OK;
+}
+
+int ps_scheduler_clear(ps_scheduler* scheduler) {
+    if (!scheduler) {
+        return PS_ERROR_INVALID_ARGUMENT;
+    }
+    try {
+        scheduler->impl->clear();
+    } catch (const std::exception&) {
+        return PS_ERROR_OUT_OF_MEMORY;
+    }
+    scheduler->scheduled = false;
+    return PS_OK;
+}
+
+int ps_scheduler_run(ps_scheduler* scheduler) {
+    if (!scheduler) {
+        return PS_ERROR_INVALID_ARGUMENT;
+    }
+    try {
+        scheduler->impl->rerun();
+    } catch (const std::exception&) {
+        scheduler->scheduled = false;
+        return PS_ERROR_OUT_OF_MEMORY;
+    }
+    scheduler->scheduled = true;
+    return PS_OK;
+}
+
+size_t ps_scheduler_size(const ps_scheduler* scheduler) {
+    return scheduler ? scheduler->impl->size() : 0;
+}
+
+int ps_scheduler_metrics(const ps_scheduler* scheduler, ps_metrics* metrics) {
+    if (!scheduler || !metrics) {
+        return PS_ERROR_INVALID_ARGUMENT;
+    }
+    if (!scheduler->scheduled) {
+        return PS_ERROR_NOT_SCHEDULED;
+    }
+    ScheduleMetrics m = scheduler->impl->metrics();
+    *metrics = {m.avgWaitingTime, m.avgTurnaroundTime, m.avgResponseTime, m.throughput};
+    return PS_OK;
+}
+
+ptrdiff_t ps_scheduler_results(const ps_scheduler* scheduler, ps_result* out, size_t capacity) {
+    if (!scheduler || (!out && capacity > 0)) {
+        return PS_ERROR_INVALID_ARGUMENT;
+    }
+    if (!scheduler->scheduled) {
+        return PS_ERROR_NOT_SCHEDULED;
+    }
+    size_t count = std::min(capacity, scheduler->impl->size());
+    for (size_t k = 0; k < count; ++k) {
+        Process p = scheduler->impl->result(k);
+        out[k] = {p.id, p.arrivalTime, p.burstTime, p.priority,
+                  p.completionTime, p.turnaroundTime, p.waitingTime, p.responseTime};
+    }
+    return static_cast<ptrdiff_t>(count);
+}
+
+const int32_t* ps_scheduler_completion_times(const ps_scheduler* scheduler) {
+    return scheduler && scheduler->scheduled ? scheduler->impl->completionTimes().data() : nullptr;
+}
+
+const int32_t* ps_scheduler_response_times(const ps_scheduler* scheduler) {
+    return scheduler && scheduler->scheduled ? scheduler->impl->responseTimes().data() : nullptr;
+}
+
+}
+
+#ifdef PROCESS_SCHEDULING_SELF_TEST
+// Prints each failed check; returns the number of failures.
+inline int selfTestFailures() {
+    int failures = 0;
+    auto check = [&](bool ok, std::string_view what) {
+        if (!ok) {
+            std::cerr << "Self-test failed: " << what << std::endl;
+            failures++;
+        }
+    };
+
+    check(fixedSchedulerAllocations() == 0, "fixed-capacity schedulers allocate");
+
+    // Nothing has completed when these all arrive, so every estimate is the
+    // initial one and both predictive policies fall back to FCFS order.
+    std::vector<Process> simultaneous;
+    for (int k = 0; k < 8; ++k) {
+        simultaneous.emplace_back(k + 1, 0, 8 - k);
+    }
+    PredictiveSJFScheduler predictiveSjf;
+    PredictiveSRTFScheduler predictiveSrtf;
+    for (Scheduler* scheduler : {static_cast<Scheduler*>(&predictiveSjf), static_cast<Scheduler*>(&predictiveSrtf)}) {
+        scheduler->addProcesses(simultaneous);
+        scheduler->schedule();
+        auto completions = scheduler->completionTimes();
+        check(std::ranges::is_sorted(completions), "equal burst estimates do not run in arrival order");
+    }
+
+    // A damaged trace must be rejected before the reader sizes anything from it.
+    std::ostringstream trace;
+    CompressedTraceWriter writer(trace);
+    for (const auto& p : sampleProcesses) {
+        writer.add({p.id, p.arrivalTime, p.burstTime, p.priority});
+    }
+    writer.finish();
+    auto rejects = [](std::string bytes) {
+        std::istringstream in(bytes);
+        CompressedTraceReader reader(in);
+        std::vector<ProcessInput> rows;
+        try {
+            while (reader.next(rows)) {
+            }
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    std::string intact = trace.str();
+    check(!rejects(intact), "intact compressed trace rejected");
+    check(rejects(intact.substr(0, intact.size() - 6)), "truncated compressed trace accepted");
+    std::string oversized = intact;
+    oversized.replace(8, 4, "\xff\xff\xff\x7f");
+    check(rejects(oversized), "compressed block with 0x7fffffff rows accepted");
+    std::string miscounted = intact;
+    miscounted[12]--;
+    check(rejects(miscounted), "compressed column with a wrong data length accepted");
+    return failures;
+}
+#endif
+
+#ifndef PROCESS_SCHEDULING_NO_MAIN
+int main() {
+#ifdef PROCESS_SCHEDULING_SELF_TEST
+    if (selfTestFailures() > 0) {
+        return 1;
+    }
+#endif
+
+    // One input table shared by every scheduler; each keeps only its result columns.
+    auto processes = makeProcessTable(sampleProcesses);
+
+    for (std::string_view spec : {"fcfs", "sjf", "srtf", "rr:2", "priority"}) {
+        std::unique_ptr<Scheduler> scheduler = makeScheduler(spec);
+        scheduler->setInput(processes);
+        scheduler->rerun();
+        scheduler->printResults();
+        std::cout << std::string(50, '-') << std::endl;
     }
 
     return 0;
 }
+#endif
 
 // FCFS: O(n log n)
 
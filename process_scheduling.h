@@ -0,0 +1,94 @@
+/*
+ * C interface to the schedulers in process_scheduling.cpp, for embedding them
+ * in another process. Build the library with:
+ *
+ *   g++ -std=c++20 -O2 -fPIC -shared -DPROCESS_SCHEDULING_NO_MAIN \
+ *       process_scheduling.cpp -o libprocess_scheduling.so
+ *
+ * Processes are kept in arrival order (ties keep insertion order), and every
+ * per-process result below is indexed in that order.
+ */
+#ifndef PROCESS_SCHEDULING_H
+#define PROCESS_SCHEDULING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#define PS_API __declspec(dllexport)
+#else
+#define PS_API __attribute__((visibility("default")))
+#endif
+
+#define PS_ABI_VERSION 1
+
+enum {
+    PS_OK = 0,
+    PS_ERROR_INVALID_ARGUMENT = -1,
+    PS_ERROR_OUT_OF_MEMORY = -2,
+    PS_ERROR_NOT_SCHEDULED = -3
+};
+
+typedef struct ps_scheduler ps_scheduler;
+
+typedef struct ps_process {
+    int32_t id;
+    int32_t arrival_time;
+    int32_t burst_time;
+    int32_t priority;
+} ps_process;
+
+typedef struct ps_result {
+    int32_t id;
+    int32_t arrival_time;
+    int32_t burst_time;
+    int32_t priority;
+    int32_t completion_time;
+    int32_t turnaround_time;
+    int32_t waiting_time;
+    int32_t response_time;
+} ps_result;
+
+typedef struct ps_metrics {
+    double avg_waiting_time;
+    double avg_turnaround_time;
+    double avg_response_time;
+    double throughput;
+} ps_metrics;
+
+PS_API uint32_t ps_abi_version(void);
+
+/* policy is one of "fcfs", "sjf", "srtf", "rr:<quantum>", "priority" or
+ * "preemptive-priority". Returns NULL for an unknown spec. */
+PS_API ps_scheduler* ps_scheduler_create(const char* policy);
+PS_API void ps_scheduler_destroy(ps_scheduler* scheduler);
+
+PS_API int ps_scheduler_reserve(ps_scheduler* scheduler, size_t count);
+PS_API int ps_scheduler_add_processes(ps_scheduler* scheduler, const ps_process* processes, size_t count);
+PS_API int ps_scheduler_clear(ps_scheduler* scheduler);
+PS_API int ps_scheduler_run(ps_scheduler* scheduler);
+
+PS_API size_t ps_scheduler_size(const ps_scheduler* scheduler);
+PS_API int ps_scheduler_metrics(const ps_scheduler* scheduler, ps_metrics* metrics);
+
+/* Copies up to capacity results into out; returns the number copied or an error.
+ * A process that had not finished when a run stopped early has completion,
+ * turnaround and waiting times of 0, and a response time of -1 if it never ran. */
+PS_API ptrdiff_t ps_scheduler_results(const ps_scheduler* scheduler, ps_result* out, size_t capacity);
+
+/* Zero-copy result columns, valid until the scheduler is next modified, run or
+ * destroyed. NULL before the first run. After an early stop, the completion
+ * time of a process that had not finished is -1, as is the response time of
+ * one that never ran. */
+PS_API const int32_t* ps_scheduler_completion_times(const ps_scheduler* scheduler);
+PS_API const int32_t* ps_scheduler_response_times(const ps_scheduler* scheduler);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif